@@ -0,0 +1,114 @@
+#include "celero/Celero.h"
+
+#include "SPIRIT/Base.hpp"
+
+#include <numeric>
+#include <vector>
+
+CELERO_MAIN
+
+
+////////////////////////////////////////////////////////////
+// Benchmark of the cost of assertions in a tight loop
+//
+// - Unchecked: no assertion
+// - InlineThrow: the previous SPIRIT_ASSERT, formatting and throwing inline
+// - Assert: SPIRIT_ASSERT, failure path in a cold function
+//
+// n: number of elements checked per iteration
+////////////////////////////////////////////////////////////
+
+#define INLINE_THROW_ASSERT(COND, ...)                                         \
+    if (!(COND))                                                               \
+    {                                                                          \
+        throw(sp::AssertionError{__VA_ARGS__});                                \
+    }
+
+
+class LoopFixture : public celero::TestFixture
+{
+public:
+
+    virtual std::vector<celero::TestFixture::ExperimentValue>
+    getExperimentValues() const override
+    {
+        std::vector<celero::TestFixture::ExperimentValue> problemSpace;
+
+        for (int n = 64; n <= 65536; n *= 8)
+            problemSpace.push_back({n, 0});
+
+        return problemSpace;
+    }
+
+    virtual void
+    setUp(const celero::TestFixture::ExperimentValue & experimentValue) override
+    {
+        values.resize(experimentValue.Value);
+        std::iota(values.begin(), values.end(), 0);
+    }
+
+    std::vector<sp::Int64> values;
+};
+
+// Separate functions so that call site bloat affects inlining
+// decisions like it would in user code.
+
+sp::Int64
+sumUnchecked(const std::vector<sp::Int64> & values)
+{
+    sp::Int64 sum = 0;
+    for (sp::Int64 v : values) sum += v;
+    return sum;
+}
+
+sp::Int64
+sumInlineThrow(const std::vector<sp::Int64> & values)
+{
+    sp::Int64 sum = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        INLINE_THROW_ASSERT(
+            values[i] >= 0,
+            "Negative value {} at index {} of {}",
+            values[i],
+            i,
+            values.size()
+        );
+        sum += values[i];
+    }
+    return sum;
+}
+
+sp::Int64
+sumAssert(const std::vector<sp::Int64> & values)
+{
+    sp::Int64 sum = 0;
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        SPIRIT_ASSERT(
+            values[i] >= 0,
+            "Negative value {} at index {} of {}",
+            values[i],
+            i,
+            values.size()
+        );
+        sum += values[i];
+    }
+    return sum;
+}
+
+
+BASELINE_F(Loop, Unchecked, LoopFixture, 30, 1000)
+{
+    celero::DoNotOptimizeAway(sumUnchecked(this->values));
+}
+
+BENCHMARK_F(Loop, InlineThrow, LoopFixture, 30, 1000)
+{
+    celero::DoNotOptimizeAway(sumInlineThrow(this->values));
+}
+
+BENCHMARK_F(Loop, Assert, LoopFixture, 30, 1000)
+{
+    celero::DoNotOptimizeAway(sumAssert(this->values));
+}
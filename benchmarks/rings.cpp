@@ -0,0 +1,168 @@
+#include "celero/Celero.h"
+
+#include "SPIRIT/Base.hpp"
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+CELERO_MAIN
+
+
+////////////////////////////////////////////////////////////
+// Throughput of handing integers from producer threads to one consumer
+//
+// - MutexDeque: std::deque behind a std::mutex
+// - Spsc: SpscRing, one element at a time
+// - SpscBatch: SpscRing, batches of 32
+// - Mpsc: MpscRing with 1 producer, then MpscRing4 with 4 producers
+//
+// n: number of elements handed over per iteration
+////////////////////////////////////////////////////////////
+
+class HandoffFixture : public celero::TestFixture
+{
+public:
+
+    virtual std::vector<celero::TestFixture::ExperimentValue>
+    getExperimentValues() const override
+    {
+        std::vector<celero::TestFixture::ExperimentValue> problemSpace;
+
+        for (int n = 1 << 12; n <= 1 << 18; n <<= 3)
+            problemSpace.push_back({n, 0});
+
+        return problemSpace;
+    }
+
+    virtual void
+    setUp(const celero::TestFixture::ExperimentValue & experimentValue) override
+    {
+        count = experimentValue.Value;
+    }
+
+    sp::Uint64 count = 0;
+};
+
+
+template <class PushOne, class PopOne>
+sp::Uint64
+handoff(sp::Uint64 count, int nProducers, PushOne pushOne, PopOne popOne)
+{
+    std::vector<std::thread> producers{};
+    for (int p = 0; p < nProducers; ++p)
+    {
+        producers.emplace_back(
+            [&, p]()
+            {
+                for (sp::Uint64 i = p; i < count; i += nProducers)
+                {
+                    while (!pushOne(i)) std::this_thread::yield();
+                }
+            }
+        );
+    }
+
+    sp::Uint64 sum = 0;
+    for (sp::Uint64 received = 0; received < count;)
+    {
+        sp::Uint64 n = popOne(sum);
+        if (n == 0)
+            std::this_thread::yield();
+        received += n;
+    }
+
+    for (auto & producer : producers) producer.join();
+    return sum;
+}
+
+
+BASELINE_F(Handoff, MutexDeque, HandoffFixture, 10, 20)
+{
+    std::mutex mutex{};
+    std::deque<sp::Uint64> queue{};
+
+    auto push = [&](sp::Uint64 value)
+    {
+        std::lock_guard lock{mutex};
+        queue.push_back(value);
+        return true;
+    };
+    auto pop = [&](sp::Uint64 & sum) -> sp::Uint64
+    {
+        std::lock_guard lock{mutex};
+        if (queue.empty())
+            return 0;
+        sum += queue.front();
+        queue.pop_front();
+        return 1;
+    };
+
+    celero::DoNotOptimizeAway(handoff(this->count, 1, push, pop));
+}
+
+BENCHMARK_F(Handoff, Spsc, HandoffFixture, 10, 20)
+{
+    sp::SpscRing<sp::Uint64> ring{1024};
+
+    auto push = [&](sp::Uint64 value) { return ring.tryPush(value); };
+    auto pop  = [&](sp::Uint64 & sum) -> sp::Uint64
+    {
+        sp::Uint64 value = 0;
+        if (!ring.tryPop(value))
+            return 0;
+        sum += value;
+        return 1;
+    };
+
+    celero::DoNotOptimizeAway(handoff(this->count, 1, push, pop));
+}
+
+BENCHMARK_F(Handoff, SpscBatch, HandoffFixture, 10, 20)
+{
+    sp::SpscRing<sp::Uint64> ring{1024};
+
+    auto push = [&](sp::Uint64 value) { return ring.tryPush(value); };
+    auto pop  = [&](sp::Uint64 & sum) -> sp::Uint64
+    {
+        sp::Uint64 values[32];
+        std::size_t n = ring.tryPopBatch(values, 32);
+        for (std::size_t i = 0; i < n; ++i) sum += values[i];
+        return n;
+    };
+
+    celero::DoNotOptimizeAway(handoff(this->count, 1, push, pop));
+}
+
+BENCHMARK_F(Handoff, Mpsc, HandoffFixture, 10, 20)
+{
+    sp::MpscRing<sp::Uint64> ring{1024};
+
+    auto push = [&](sp::Uint64 value) { return ring.tryPush(value); };
+    auto pop  = [&](sp::Uint64 & sum) -> sp::Uint64
+    {
+        sp::Uint64 values[32];
+        std::size_t n = ring.tryPopBatch(values, 32);
+        for (std::size_t i = 0; i < n; ++i) sum += values[i];
+        return n;
+    };
+
+    celero::DoNotOptimizeAway(handoff(this->count, 1, push, pop));
+}
+
+BENCHMARK_F(Handoff, Mpsc4, HandoffFixture, 10, 20)
+{
+    sp::MpscRing<sp::Uint64> ring{1024};
+
+    auto push = [&](sp::Uint64 value) { return ring.tryPush(value); };
+    auto pop  = [&](sp::Uint64 & sum) -> sp::Uint64
+    {
+        sp::Uint64 values[32];
+        std::size_t n = ring.tryPopBatch(values, 32);
+        for (std::size_t i = 0; i < n; ++i) sum += values[i];
+        return n;
+    };
+
+    celero::DoNotOptimizeAway(handoff(this->count, 4, push, pop));
+}
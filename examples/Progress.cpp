@@ -0,0 +1,37 @@
+#include "SPIRIT/Base.hpp"
+
+#include <thread>
+#include <vector>
+
+int
+main(int argc, char ** argv)
+{
+    sp::ProgressGroup progress{};
+
+    // Log records are written above the bars
+    progress.attach(sp::spiritLogger());
+
+    std::vector<std::thread> workers{};
+    for (int i = 0; i < 8; ++i)
+    {
+        sp::ProgressBar bar = progress.addBar(sp::format("Worker #{}", i), 200);
+
+        workers.emplace_back(
+            [bar, i]() mutable
+            {
+                for (int step = 0; step < 200; ++step)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds{5 + i});
+                    bar.advance(); // never waits on the output
+                }
+
+                sp::spiritLog() << sp::Info{"Worker #{} is done", i};
+            }
+        );
+    }
+
+    for (auto & worker : workers) worker.join();
+
+    progress.stop();
+    return 0;
+}
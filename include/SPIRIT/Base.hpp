@@ -47,9 +47,26 @@
 
 #include "Base/Logging/Logging.hpp"
 
+#include "Base/Error/CrashHandler.hpp"
 #include "Base/Error/Error.hpp"
+#include "Base/Error/Result.hpp"
+
+#include "Base/Utils/Concurrency/Ring.hpp"
+
+#include "Base/Utils/Containers/Bucket.hpp"
+#include "Base/Utils/Containers/BucketList.hpp"
+#include "Base/Utils/Containers/SoA.hpp"
+
+#include "Base/Utils/Memory/FrameArena.hpp"
+#include "Base/Utils/Memory/ObjectPool.hpp"
+
+#include "Base/Utils/Profiling/ProfileScope.hpp"
+#include "Base/Utils/Profiling/Profiler.hpp"
 
 #include "Base/Utils/Time/Clock.hpp"
+#include "Base/Utils/Time/FixedTimestep.hpp"
+#include "Base/Utils/Time/Histogram.hpp"
 #include "Base/Utils/Time/Timer.hpp"
+#include "Base/Utils/Time/TimerWheel.hpp"
 
 #endif // SPIRIT_BASE_HPP
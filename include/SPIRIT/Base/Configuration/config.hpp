@@ -102,6 +102,55 @@
 #endif
 
 
+////////////////////////////////////////////////////////////
+/// \ingroup Configuration
+/// \brief Selects which assertions are compiled
+///
+/// - SPIRIT_ASSERT_LEVEL_OFF: no assertions are checked
+/// - SPIRIT_ASSERT_LEVEL_CHEAP: only SPIRIT_ASSERT is checked
+/// - SPIRIT_ASSERT_LEVEL_FULL: SPIRIT_ASSERT_FULL is also checked
+///
+/// Defaults to full in debug and to cheap otherwise.
+////////////////////////////////////////////////////////////
+#define SPIRIT_ASSERT_LEVEL_OFF   0
+#define SPIRIT_ASSERT_LEVEL_CHEAP 1
+#define SPIRIT_ASSERT_LEVEL_FULL  2
+
+#ifndef SPIRIT_ASSERT_LEVEL
+#    if defined(SPIRIT_DEBUG)
+#        define SPIRIT_ASSERT_LEVEL SPIRIT_ASSERT_LEVEL_FULL
+#    else
+#        define SPIRIT_ASSERT_LEVEL SPIRIT_ASSERT_LEVEL_CHEAP
+#    endif
+#endif
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Configuration
+/// \brief Enables SPIRIT_PROFILE_SCOPE and SPIRIT_PROFILE_FUNCTION
+///
+/// When disabled (the default), the profiling macros expand to
+/// nothing and cost nothing.
+///
+/// Enable by defining SPIRIT_PROFILE to SPIRIT_TRUE
+////////////////////////////////////////////////////////////
+#ifndef SPIRIT_PROFILE
+#    define SPIRIT_PROFILE SPIRIT_FALSE
+#endif
+
+
+////////////////////////////////////////////////////////////
+// Hints for rarely executed functions (ie error handling)
+////////////////////////////////////////////////////////////
+#if defined(_MSC_VER)
+#    define SPIRIT_NOINLINE __declspec(noinline)
+#    define SPIRIT_COLD
+#else
+#    define SPIRIT_NOINLINE __attribute__((noinline))
+#    define SPIRIT_COLD     __attribute__((cold))
+#endif
+
+
 namespace sp
 {
 
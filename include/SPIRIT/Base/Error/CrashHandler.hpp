@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_CRASHHANDLER_HPP
+#define SPIRIT_CRASHHANDLER_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "SPIRIT/Base/Logging/AnsiStream.hpp"
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+/// \ingroup Errors
+/// \brief Traps fatal signals to report crashes
+///
+/// Handles SIGSEGV, SIGABRT, SIGBUS and SIGFPE (SIGBUS does not exist
+/// on Windows). When one is received:
+/// - a raw stacktrace (frame addresses) is written to stderr,
+///   symbols can then be found with tools like addr2line.
+/// - registered file buffers are flushed, on a best effort basis.
+/// - the previous handler is restored and the signal is raised again.
+///
+/// The stacktrace is written with async-signal-safe calls only.
+/// Flushing may not be, see registerCrashFlush.
+///
+/// Installing registers sp::ansiOut, sp::ansiErr and the AnsiFileSinks
+/// of spiritLogger(). Sinks destroyed later, once replaced for example,
+/// unregister themselves.
+/// Calling it more than once has no effect.
+///
+/// Stack overflows are handled on an alternate stack (POSIX only).
+/// Alternate stacks are per thread: the calling thread gets one,
+/// other threads must call installCrashStack.
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API void
+installCrashHandler();
+
+////////////////////////////////////////////////////////////
+/// \ingroup Errors
+/// \brief Gives the calling thread an alternate stack, so that the
+/// crash handler can report its stack overflows (POSIX only)
+///
+/// Other crashes are reported from any thread without it.
+/// The stack is removed when the thread exits.
+/// Calling it more than once has no effect.
+////////////////////////////////////////////////////////////
+SPIRIT_API void
+installCrashStack();
+
+////////////////////////////////////////////////////////////
+/// \ingroup Errors
+/// \brief Restores the signal handlers that were replaced by
+/// installCrashHandler
+///
+/// Registered buffers stay registered.
+////////////////////////////////////////////////////////////
+SPIRIT_API void
+uninstallCrashHandler();
+
+////////////////////////////////////////////////////////////
+/// \ingroup Errors
+/// \brief Flush buf's pending output when crashing
+///
+/// Output already passed to the FILE is flushed first, if the FILE is not
+/// locked by another call (POSIX only). Then the output still in buf is
+/// written directly to the file descriptor.
+/// The buffer is read as is, output of a thread writing to it
+/// during the crash may be cut.
+///
+/// buf unregisters itself when destroyed. Its FILE must stay open
+/// while it is registered, the file descriptor is kept to write to it.
+///
+/// \return false if too many buffers are registered
+////////////////////////////////////////////////////////////
+SPIRIT_API bool
+registerCrashFlush(sp::details::OutFileBuf & buf);
+
+SPIRIT_API void
+unregisterCrashFlush(sp::details::OutFileBuf & buf);
+
+////////////////////////////////////////////////////////////
+/// \ingroup Errors
+/// \brief Registers the buffer of an AnsiFileStream, or an AnsiFileSink
+///
+////////////////////////////////////////////////////////////
+inline bool
+registerCrashFlush(sp::AnsiFileStream & stream)
+{
+    return registerCrashFlush(stream.stream().buffer());
+}
+
+inline void
+unregisterCrashFlush(sp::AnsiFileStream & stream)
+{
+    unregisterCrashFlush(stream.stream().buffer());
+}
+
+} // namespace sp
+
+
+#endif // SPIRIT_CRASHHANDLER_HPP
@@ -29,6 +29,9 @@
 #include "SPIRIT/Base/Logging/Format.hpp"
 
 #include <exception>
+#include <memory>
+#include <string_view>
+#include <type_traits>
 
 
 namespace sp
@@ -47,6 +50,17 @@ namespace sp
 /// \see Configuration
 ////////////////////////////////////////////////////////////
 
+namespace details
+{
+struct ErrorData;
+
+// Copies must not be taken as a message
+template <class Error, class... Args>
+constexpr bool isErrorCopy
+    = sizeof...(Args) == 1
+      && (std::is_base_of_v<Error, std::remove_cvref_t<Args>> && ...);
+} // namespace details
+
 ////////////////////////////////////////////////////////////
 /// \ingroup Errors
 /// \brief Base error class of the Spirit library
@@ -55,46 +69,76 @@ namespace sp
 /// printable object (defines friend operator<<(std::ostream &, printable))
 /// \see sp::format
 ///
-/// Base error class which builds a stack trace when constructed
+/// Base error class which captures a stack trace when constructed
 /// and includes it in Error::what()
 ///
+/// Only the raw frame addresses are captured on construction,
+/// symbols are resolved on the first call to what() (or operator<<).
+/// Errors that are caught and handled without being printed
+/// never pay for symbolization.
+/// Symbolized frames are kept in a process wide cache
+/// (details::SymbolCache::global()), so repeated errors are cheap to print.
+///
+/// Copies share the captured frames and the built explanation.
+///
 ////////////////////////////////////////////////////////////
 class SPIRIT_API SpiritError : public std::exception
 {
 public:
 
-    template <class... Args>
+    template <
+        class... Args,
+        std::enable_if_t<!details::isErrorCopy<SpiritError, Args...>, bool> = true>
     SpiritError(Args &&... args) : SpiritError{}
     {
-        explanation += std::string{"Error message: \n"}
-                       + sp::format(std::forward<Args>(args)...) + "\n";
+        setMessage(sp::format(std::forward<Args>(args)...));
     }
 
-
-#if !SPIRIT_USE_STACKTRACE
-    SpiritError() = default;
-#else
-    // Creates a stacktrace on construction, prepended to this->explanation
+    // Captures the stacktrace when SPIRIT_USE_STACKTRACE is enabled
     SpiritError();
-#endif
 
-    const char *
-    what() const noexcept override
+    SpiritError(const SpiritError &) = default;
+
+    // Moves copy, so that a moved from error can still be printed
+    SpiritError(SpiritError && other) noexcept : SpiritError{other} {}
+
+    SpiritError &
+    operator=(const SpiritError &) = default;
+
+    SpiritError &
+    operator=(SpiritError && other) noexcept
     {
-        return explanation.c_str();
+        return *this = other;
     }
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Stacktrace followed by the error message
+    ///
+    /// Built once, on the first call.
+    ////////////////////////////////////////////////////////////
+    const char *
+    what() const noexcept override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Error message only, does not resolve the stacktrace
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::string_view
+    message() const noexcept;
 
     friend std::ostream &
     operator<<(std::ostream & os, const SpiritError & error)
     {
-        return os << error.explanation;
+        return os << error.what();
     }
 
 
 private:
 
-    std::string explanation;
+    void
+    setMessage(std::string && msg);
+
+    std::shared_ptr<details::ErrorData> data;
 };
 
 
@@ -109,16 +153,63 @@ class SPIRIT_API AssertionError : public SpiritError
 };
 
 
+namespace details
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Failure path of assertions, kept out of the callers
+///
+/// Formatting and building the error only happens here.
+/// Arguments are taken by reference, they may be large or not copyable.
+////////////////////////////////////////////////////////////
+template <class... Args>
+[[noreturn]] SPIRIT_NOINLINE SPIRIT_COLD void
+assertionFailed(const Args &... args)
+{
+    throw sp::AssertionError{args...};
+}
+
+} // namespace details
+
+
 ////////////////////////////////////////////////////////////
 /// \ingroup Errors
 /// \brief Assertion macro, takes a Condition and params to sp::SpiritError constructor
 ///
+/// Checked unless SPIRIT_ASSERT_LEVEL is SPIRIT_ASSERT_LEVEL_OFF.
+/// Arguments are only evaluated when the condition fails.
+///
+////////////////////////////////////////////////////////////
+#if SPIRIT_ASSERT_LEVEL >= SPIRIT_ASSERT_LEVEL_CHEAP
+#    define SPIRIT_ASSERT(COND, ...)                                           \
+        do                                                                     \
+        {                                                                      \
+            if (!(COND)) [[unlikely]]                                          \
+                sp::details::assertionFailed(__VA_ARGS__);                     \
+        } while (false)
+#else
+#    define SPIRIT_ASSERT(COND, ...) SPIRIT_ASSERT_UNCHECKED(COND)
+#endif
+
+////////////////////////////////////////////////////////////
+/// \ingroup Errors
+/// \brief Same as SPIRIT_ASSERT, for expensive checks
+///
+/// Only checked when SPIRIT_ASSERT_LEVEL is SPIRIT_ASSERT_LEVEL_FULL.
+///
 ////////////////////////////////////////////////////////////
-#define SPIRIT_ASSERT(COND, ...)                                               \
-    if (!(COND))                                                               \
+#if SPIRIT_ASSERT_LEVEL >= SPIRIT_ASSERT_LEVEL_FULL
+#    define SPIRIT_ASSERT_FULL(COND, ...) SPIRIT_ASSERT(COND, __VA_ARGS__)
+#else
+#    define SPIRIT_ASSERT_FULL(COND, ...) SPIRIT_ASSERT_UNCHECKED(COND)
+#endif
+
+// The condition must still compile, but is not evaluated
+#define SPIRIT_ASSERT_UNCHECKED(COND)                                          \
+    do                                                                         \
     {                                                                          \
-        throw(sp::AssertionError{__VA_ARGS__});                                \
-    }
+        (void)sizeof(!(COND));                                                 \
+    } while (false)
 
 
 } // namespace sp
@@ -0,0 +1,381 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_RESULT_HPP
+#define SPIRIT_RESULT_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "Error.hpp"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace sp
+{
+
+namespace details
+{
+
+struct LazyMessage
+{
+    virtual ~LazyMessage() = default;
+
+    virtual std::string
+    format() const = 0;
+};
+
+template <class... Args>
+struct LazyMessageImpl : LazyMessage
+{
+    template <class... CtorArgs>
+    explicit LazyMessageImpl(CtorArgs &&... args)
+        : args{std::forward<CtorArgs>(args)...}
+    {
+    }
+
+    std::string
+    format() const override
+    {
+        return std::apply(
+            [](const auto &... a) { return sp::format(a...); },
+            args
+        );
+    }
+
+    std::tuple<Args...> args;
+};
+
+// A message copied as is, not a format string
+struct OwnedMessage : LazyMessage
+{
+    explicit OwnedMessage(std::string_view text) : text{text} {}
+
+    std::string
+    format() const override
+    {
+        return text;
+    }
+
+    std::string text;
+};
+
+// Strings that don't own their characters are copied,
+// they may not outlive the Failure
+template <class T>
+using StoredArg = std::conditional_t<
+    std::is_same_v<std::decay_t<T>, const char *> || std::is_same_v<std::decay_t<T>, char *>
+        || std::is_same_v<std::decay_t<T>, std::string_view>,
+    std::string,
+    std::decay_t<T>>;
+
+} // namespace details
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Errors
+/// \brief Expected failure, carried by a Result
+///
+/// Holds an error code and an optional message.
+///
+/// The message arguments are stored and only formatted (with sp::format)
+/// when message() is called. Strings are copied, they may be temporaries.
+/// A code alone does not allocate.
+///
+/// Unlike SpiritError, no stacktrace is captured, use toError() or raise()
+/// when the failure cannot be handled.
+///
+////////////////////////////////////////////////////////////
+class Failure
+{
+public:
+
+    explicit Failure(sp::Int32 code) : errorCode{code} {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Message copied as is, not formatted
+    ///
+    ////////////////////////////////////////////////////////////
+    Failure(sp::Int32 code, std::string_view message)
+        : errorCode{code},
+          lazy{std::make_shared<details::OwnedMessage>(message)}
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Formatted message, the format string and arguments are copied
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class... Args>
+        requires(sizeof...(Args) > 0)
+    Failure(sp::Int32 code, std::string_view formatString, Args &&... args)
+        : errorCode{code},
+          lazy{std::make_shared<details::LazyMessageImpl<std::string, details::StoredArg<Args>...>>(
+              formatString,
+              std::forward<Args>(args)...
+          )}
+    {
+    }
+
+    [[nodiscard]] sp::Int32
+    code() const noexcept
+    {
+        return errorCode;
+    }
+
+    [[nodiscard]] bool
+    hasMessage() const noexcept
+    {
+        return lazy != nullptr;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Formats the message, empty if there is none
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::string
+    message() const
+    {
+        return lazy ? lazy->format() : std::string{};
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Escalates to a SpiritError, capturing the stacktrace here
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] SPIRIT_NOINLINE SPIRIT_COLD sp::SpiritError
+    toError() const
+    {
+        if (hasMessage())
+            return sp::SpiritError{"Failure {}: {}", errorCode, message()};
+
+        return sp::SpiritError{"Failure {}", errorCode};
+    }
+
+    [[noreturn]] SPIRIT_NOINLINE SPIRIT_COLD void
+    raise() const
+    {
+        throw toError();
+    }
+
+    friend std::ostream &
+    operator<<(std::ostream & os, const Failure & failure)
+    {
+        os << "Failure " << failure.code();
+        if (failure.hasMessage())
+            os << ": " << failure.message();
+
+        return os;
+    }
+
+private:
+
+    sp::Int32 errorCode;
+
+    std::shared_ptr<const details::LazyMessage> lazy{};
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Errors
+/// \brief Holds either a value or a Failure
+///
+/// Lightweight alternative to throwing for expected failures
+/// (parsing, validation, ...):
+///
+/// \code
+/// sp::Result<int>
+/// parseDigit(char c)
+/// {
+///     if (c < '0' || c > '9')
+///         return sp::Failure{1, "'{}' is not a digit", c};
+///
+///     return c - '0';
+/// }
+/// \endcode
+///
+/// Accessing the value of a failed Result raises the Failure
+/// as a SpiritError.
+///
+////////////////////////////////////////////////////////////
+template <class T>
+class Result
+{
+public:
+
+    typedef T ValueType;
+
+    template <
+        class U = T,
+        std::enable_if_t<
+            std::is_constructible_v<T, U &&>
+                && !std::is_same_v<std::remove_cvref_t<U>, Result>
+                && !std::is_same_v<std::remove_cvref_t<U>, Failure>,
+            bool> = true>
+    Result(U && value) : content{std::in_place_index<0>, std::forward<U>(value)}
+    {
+    }
+
+    Result(Failure failure) : content{std::in_place_index<1>, std::move(failure)}
+    {
+    }
+
+    [[nodiscard]] bool
+    hasValue() const noexcept
+    {
+        return content.index() == 0;
+    }
+
+    explicit
+    operator bool() const noexcept
+    {
+        return hasValue();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief The value, raises the Failure if there is none
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] T &
+    value() &
+    {
+        check();
+        return *std::get_if<0>(&content);
+    }
+
+    [[nodiscard]] const T &
+    value() const &
+    {
+        check();
+        return *std::get_if<0>(&content);
+    }
+
+    [[nodiscard]] T &&
+    value() &&
+    {
+        check();
+        return std::move(*std::get_if<0>(&content));
+    }
+
+    template <class U>
+    [[nodiscard]] T
+    valueOr(U && fallback) const &
+    {
+        return hasValue() ? *std::get_if<0>(&content)
+                          : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    template <class U>
+    [[nodiscard]] T
+    valueOr(U && fallback) &&
+    {
+        return hasValue() ? std::move(*std::get_if<0>(&content))
+                          : static_cast<T>(std::forward<U>(fallback));
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief The Failure, requires !hasValue()
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] const Failure &
+    failure() const
+    {
+        SPIRIT_ASSERT_FULL(!hasValue(), "Result holds a value");
+        return *std::get_if<1>(&content);
+    }
+
+private:
+
+    void
+    check() const
+    {
+        if (!hasValue()) [[unlikely]]
+            std::get_if<1>(&content)->raise();
+    }
+
+    std::variant<T, Failure> content;
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Errors
+/// \brief Result of an operation that has no value
+///
+////////////////////////////////////////////////////////////
+template <>
+class Result<void>
+{
+public:
+
+    typedef void ValueType;
+
+    Result() = default;
+
+    Result(Failure failure) : content{std::move(failure)} {}
+
+    [[nodiscard]] bool
+    hasValue() const noexcept
+    {
+        return content.index() == 0;
+    }
+
+    explicit
+    operator bool() const noexcept
+    {
+        return hasValue();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Raises the Failure if there is one
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    value() const
+    {
+        if (!hasValue()) [[unlikely]]
+            std::get_if<1>(&content)->raise();
+    }
+
+    [[nodiscard]] const Failure &
+    failure() const
+    {
+        SPIRIT_ASSERT_FULL(!hasValue(), "Result holds a value");
+        return *std::get_if<1>(&content);
+    }
+
+private:
+
+    std::variant<std::monostate, Failure> content{};
+};
+
+} // namespace sp
+
+
+#endif // SPIRIT_RESULT_HPP
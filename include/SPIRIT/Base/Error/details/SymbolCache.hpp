@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_SYMBOLCACHE_HPP
+#define SPIRIT_SYMBOLCACHE_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace sp
+{
+namespace details
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Thread safe, bounded cache of symbolized stack frames
+///
+/// Maps a frame address to its symbolized string. When full, the least
+/// recently used entry is evicted.
+///
+/// Symbols are resolved without holding the lock, two threads missing
+/// on the same address may both resolve it.
+///
+////////////////////////////////////////////////////////////
+class SPIRIT_API SymbolCache
+{
+public:
+
+    typedef std::string (*Resolver)(const void * address);
+
+    static constexpr std::size_t defaultCapacity = 1024;
+
+    explicit SymbolCache(std::size_t capacity = defaultCapacity)
+        : maxEntries{capacity}
+    {
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cache shared by all SpiritErrors
+    ///
+    ////////////////////////////////////////////////////////////
+    static SymbolCache &
+    global();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Symbol of address, calls resolve on a miss
+    ///
+    ////////////////////////////////////////////////////////////
+    std::string
+    get(const void * address, Resolver resolve);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Changes the maximum number of entries, 0 disables caching
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    setCapacity(std::size_t capacity);
+
+    [[nodiscard]] std::size_t
+    capacity() const;
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+    void
+    clear();
+
+private:
+
+    typedef std::pair<const void *, std::string> Entry;
+
+    // must be locked
+    void
+    evict(std::size_t maxSize);
+
+    mutable std::mutex mutex{};
+
+    // most recently used first
+    std::list<Entry> entries{};
+    std::unordered_map<const void *, std::list<Entry>::iterator> index{};
+    std::size_t maxEntries;
+};
+
+} // namespace details
+} // namespace sp
+
+
+#endif // SPIRIT_SYMBOLCACHE_HPP
@@ -73,7 +73,7 @@ toStr(Esc && esc)
 /// 
 ////////////////////////////////////////////////////////////
 template <class... Args>
-class Escapes : traits::EscapeType<Args...>
+class Escapes : traits::EscapeType<Args...>, details::EscapesPack
 {
     // TODO: MSVC gives a bunch of warning saying that std::tuple needs to have
     //  dll interface for clients of ... to be used
@@ -82,6 +82,17 @@ public:
     template<class... CtorArgs>
     constexpr Escapes(CtorArgs&&... args) : tup{std::forward<CtorArgs>(args)...}{}
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Calls f on each contained escape, in streaming order
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class F>
+    constexpr void
+    forEach(F && f) const
+    {
+        std::apply([&f](const Args &... escapes) { (f(escapes), ...); }, tup);
+    }
+
     friend std::ostream &
     operator<<(std::ostream & os, const Escapes & e)
     {
@@ -286,6 +297,7 @@ template <int num, char sym>
 using Erase = details::Erase<num, sym>;
 
 typedef Erase<2, 'J'> EraseScreen;
+typedef Erase<0, 'J'> EraseCursorToEndScreen;
 typedef Erase<0, 'K'> EraseCursorToEndLine;
 typedef Erase<1, 'K'> EraseStartLineToCursor;
 typedef Erase<2, 'K'> EraseLine;
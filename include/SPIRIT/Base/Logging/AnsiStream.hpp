@@ -29,10 +29,13 @@
 #include "SPIRIT/Base/Configuration/config.hpp"
 #include "AnsiEscape.hpp"
 #include "SPIRIT/Base/Concepts/Concepts.hpp"
+#include "details/AnsiStripper.hpp"
 #include "details/FileBuf.hpp"
+#include "details/SgrState.hpp"
 
 #include <memory>
 #include <sstream>
+#include <string_view>
 
 namespace sp
 {
@@ -53,6 +56,12 @@ public:
         return fileBuf.file();
     }
 
+    [[nodiscard]] sp::details::OutFileBuf &
+    buffer()
+    {
+        return fileBuf;
+    }
+
 
 private:
 
@@ -78,6 +87,13 @@ private:
 /// The inner stream can be accessed with .stream() or operator->.
 ///
 /// Filters AnsiEscapes by using operator<< overloads.
+/// Strings containing escapes have them removed when disabled.
+///
+/// When enabled, the current text style is tracked and TextStyles that
+/// would not change it are not output (ie a reset on unstyled text).
+/// Strings containing escapes are tracked too, other printable objects
+/// are expected not to output any TextStyle.
+/// If the inner stream is written to directly, call invalidateTextStyle().
 ///
 ////////////////////////////////////////////////////////////
 template <class StreamType>
@@ -179,9 +195,46 @@ public:
     void
     enableAnsi(bool on = true)
     {
+        if (on && !areSequencesEnabled)
+            textStyle.invalidate();
+
+        stripper.reset();
+
         areSequencesEnabled = on;
     }
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the tracked text style
+    ///
+    /// The next TextStyles are always output, until a reset.
+    /// Use when the inner stream (or terminal) was written to directly.
+    ////////////////////////////////////////////////////////////
+    void
+    invalidateTextStyle()
+    {
+        textStyle.invalidate();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Writes text which may contain ansi escapes
+    ///
+    /// Same as streaming the text, without formatting.
+    /// When disabled, escapes are removed (they may be split across calls).
+    ////////////////////////////////////////////////////////////
+    void
+    writeText(const char_type * str, std::streamsize n)
+    {
+        if (isAnsiEnabled())
+            sp::details::writeTracked(inner, textStyle, str, n);
+        else
+            stripper.strip(
+                str,
+                n,
+                [this](const char_type * text, std::streamsize size)
+                { inner.write(text, size); }
+            );
+    }
+
     ////////////////////////////////////////////////////////////
     /// \brief Streams AnsiEscapes when they are enabled, otherwise this is a no-op
     ///
@@ -191,7 +244,7 @@ public:
     operator<<(AnsiStreamWrapper & stream, T && seq)
     {
         if (stream.isAnsiEnabled())
-            stream.stream() << seq;
+            stream.putEscape(seq);
 
         return stream;
     }
@@ -204,6 +257,16 @@ public:
     friend AnsiStreamWrapper &
     operator<<(AnsiStreamWrapper & stream, T && obj)
     {
+        if constexpr (std::is_convertible_v<const T &, std::basic_string_view<char_type>>)
+        {
+            std::basic_string_view<char_type> str{obj};
+            if (str.find(static_cast<char_type>(AnsiEscape::ESC)) != str.npos)
+            {
+                stream.writeText(str.data(), str.size());
+                return stream;
+            }
+        }
+
         stream.stream() << obj;
         return stream;
     }
@@ -221,8 +284,38 @@ public:
 
 private:
 
+    template <class Esc>
+    void
+    putEscape(const Esc & seq)
+    {
+        if constexpr (sp::traits::isEscapesPack<Esc>::value)
+        {
+            seq.forEach([this](const auto & esc) { this->putEscape(esc); });
+        }
+        else if constexpr (sp::traits::hasSgrParams<Esc>::value)
+        {
+            if (textStyle.apply(seq.sgrParams()))
+                inner << seq;
+        }
+        else if constexpr (sp::traits::hasRenderedText<Esc>::value)
+        {
+            std::string_view text = seq.str();
+            writeText(text.data(), text.size());
+        }
+        else
+        {
+            // TerminalControls don't affect the style, unknown TextStyles might
+            inner << seq;
+            if constexpr (sp::traits::isTextStyle<Esc>::value)
+                textStyle.invalidate();
+        }
+    }
+
     bool areSequencesEnabled;
 
+    sp::details::SgrState textStyle{};
+    sp::details::AnsiStripper<char_type> stripper{};
+
     // We don't use a reference since these may go bad.
     // Also this is intended as a new stream class, not one which
     // modifies to behavior of an *existing stream object*
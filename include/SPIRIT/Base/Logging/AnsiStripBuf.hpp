@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_ANSISTRIPBUF_HPP
+#define SPIRIT_ANSISTRIPBUF_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "details/AnsiStripper.hpp"
+
+#include <streambuf>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+/// \ingroup Logging
+/// \brief Output stream buffer that removes ansi escapes before
+/// forwarding to another stream buffer
+///
+/// Unlike AnsiStreamWrapper, which filters escapes by type, this filters
+/// the characters themselves. Pre-rendered strings (sp::toStr, gradients,
+/// text from other libraries, ...) can then be written to plain files.
+///
+/// Sequences may be split across writes. The buffer is unbuffered:
+/// text between escapes is forwarded with target's sputn without
+/// being copied, buffering is left to the target (ie FileBuf).
+///
+/// The target is not owned and must outlive this buffer.
+///
+/// \code
+/// std::ofstream file{"log.txt"};
+/// sp::AnsiStripBuf strip{file.rdbuf()};
+/// std::ostream os{&strip};
+/// os << sp::toStr(sp::red) << "plain text";
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+template <class CharT>
+class BasicAnsiStripBuf : public std::basic_streambuf<CharT>
+{
+    typedef std::basic_streambuf<CharT> Base;
+
+public:
+
+    typedef typename Base::char_type char_type;
+    typedef typename Base::traits_type traits_type;
+    typedef typename Base::int_type int_type;
+    typedef typename Base::pos_type pos_type;
+    typedef typename Base::off_type off_type;
+
+    explicit BasicAnsiStripBuf(Base * target = nullptr) : targetBuf{target} {}
+
+    ~BasicAnsiStripBuf() override = default;
+
+    [[nodiscard]] Base *
+    target() const
+    {
+        return targetBuf;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Changes the target, a partially written escape is dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    setTarget(Base * target)
+    {
+        targetBuf = target;
+        stripper.reset();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief true if the last write ended inside of an escape
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool
+    inSequence() const
+    {
+        return stripper.inSequence();
+    }
+
+protected:
+
+    std::streamsize
+    xsputn(const char_type * str, std::streamsize n) override
+    {
+        if (targetBuf == nullptr)
+            return 0;
+
+        bool failed = false;
+        stripper.strip(
+            str,
+            n,
+            [this, &failed](const char_type * text, std::streamsize size)
+            {
+                failed |= targetBuf->sputn(text, size) != size;
+            }
+        );
+
+        // escapes count as written
+        return failed ? 0 : n;
+    }
+
+    int_type
+    overflow(int_type ch) override
+    {
+        if (targetBuf == nullptr)
+            return traits_type::eof();
+
+        if (traits_type::eq_int_type(ch, traits_type::eof()))
+            return traits_type::not_eof(ch);
+
+        char_type c = traits_type::to_char_type(ch);
+        return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+    }
+
+    int
+    sync() override
+    {
+        return targetBuf == nullptr ? -1 : targetBuf->pubsync();
+    }
+
+private:
+
+    Base * targetBuf;
+    sp::details::AnsiStripper<char_type> stripper{};
+};
+
+SPIRIT_API typedef BasicAnsiStripBuf<char> AnsiStripBuf;
+SPIRIT_API typedef BasicAnsiStripBuf<wchar_t> wAnsiStripBuf;
+
+} // namespace sp
+
+
+#endif // SPIRIT_ANSISTRIPBUF_HPP
@@ -30,6 +30,8 @@
 #include "spdlog/fmt/fmt.h"
 #include "spdlog/fmt/ostr.h" // needs to be included for operator<< resolution
 
+#include <iterator>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 
@@ -79,6 +81,62 @@ format(const T & printable)
 
 inline std::string format() {return "";}
 
+////////////////////////////////////////////////////////////
+/// \ingroup Logging
+/// \brief Appends the formatted arguments to a character container
+///
+/// Same arguments as sp::format, the output is appended to anything
+/// with push_back (std::string, fmt::memory_buffer...) instead of
+/// a new string:
+/// \code sp::formatTo(buffer, "{} != {}", 1, 2); \endcode
+////////////////////////////////////////////////////////////
+template <
+    class Buffer,
+    class... Args,
+    std::enable_if_t<std::conjunction<sp::traits::Printable<Args>...>::value, bool> = true>
+void
+formatTo(Buffer & buffer, std::string_view str, Args &&... args)
+{
+    fmt::vformat_to(std::back_inserter(buffer), str, fmt::make_format_args(args...));
+}
+
+template <
+    class Buffer,
+    class T,
+    std::enable_if_t<
+        sp::traits::Printable<T>::value
+            && !std::is_convertible<T, std::string_view>::value,
+        bool> = true>
+void
+formatTo(Buffer & buffer, const T & printable)
+{
+    sp::formatTo(buffer, "{}", printable);
+}
+
+template <class Buffer>
+void
+formatTo(Buffer &)
+{
+}
+
+////////////////////////////////////////////////////////////
+/// \ingroup Logging
+/// \brief Format into a string allocated from resource
+///
+/// Useful with a FrameArena's resource for short lived strings:
+/// \code sp::format(arena.getResource(), "{} fps", fps); \endcode
+////////////////////////////////////////////////////////////
+template <
+    class... Args,
+    std::enable_if_t<std::conjunction<sp::traits::Printable<Args>...>::value, bool> = true>
+std::pmr::string
+format(std::pmr::memory_resource & resource, std::string_view str, Args &&... args)
+{
+    std::pmr::string formatted{&resource};
+    sp::formatTo(formatted, str, std::forward<Args>(args)...);
+    return formatted;
+}
+
 
 } // namespace sp
 
@@ -163,6 +163,27 @@ public:
 #pragma warning ( pop )
 
 
+////////////////////////////////////////////////////////////
+/// \ingroup Loggers
+/// \brief LevelColor used by default for a given LogLevel
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] constexpr LevelColor
+defaultLevelColor(LogLevel lvl)
+{
+    switch (lvl)
+    {
+    case LogLevel::trace: return LevelColor{sp::white};
+    case LogLevel::debug: return LevelColor{sp::cyan};
+    case LogLevel::info: return LevelColor{sp::green};
+    case LogLevel::warn: return LevelColor{sp::yellow, sp::onDefault, sp::bold};
+    case LogLevel::err: return LevelColor{sp::red, sp::onDefault, sp::bold};
+    case LogLevel::critical: return LevelColor{sp::black, sp::onRed, sp::bold};
+    default: return LevelColor{};
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 /// \ingroup Loggers
 /// \brief Creates a Sink that outputs to a given ostream
@@ -227,25 +248,17 @@ protected:
 
 private:
 
-    // TODO: Does not account for generic sequences (ie cursor and erase)
-    // only for TextStyle sequences, AnsiSequences need further refinement
-    void
-    filterSequences(const char_type * start, size_t size);
-
     void
     write(const spdlog::memory_buf_t & formatted, size_t start, size_t end);
 
-    // Default colors for logging levels
-    static constexpr LevelColor trace{sp::white};
-    static constexpr LevelColor debug{sp::cyan};
-    static constexpr LevelColor info{sp::green};
-    static constexpr LevelColor warn{sp::yellow, sp::onDefault, sp::bold};
-    static constexpr LevelColor error{sp::red, sp::onDefault, sp::bold};
-    static constexpr LevelColor critical{sp::black, sp::onRed, sp::bold};
-    static constexpr LevelColor off{}; // ?
-
-    std::array<LevelColor, spdlog::level::n_levels>
-        levelColors{trace, debug, info, warn, error, critical, off};
+    std::array<LevelColor, spdlog::level::n_levels> levelColors{
+        defaultLevelColor(LogLevel::trace),
+        defaultLevelColor(LogLevel::debug),
+        defaultLevelColor(LogLevel::info),
+        defaultLevelColor(LogLevel::warn),
+        defaultLevelColor(LogLevel::err),
+        defaultLevelColor(LogLevel::critical),
+        defaultLevelColor(LogLevel::off)};
 };
 
 ////////////////////////////////////////////////////////////
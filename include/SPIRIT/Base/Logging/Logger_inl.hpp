@@ -96,40 +96,6 @@ AnsiStreamSink<Stream, Mutex>::sink_it_(const spdlog::details::log_msg & msg)
 }
 
 
-// TODO: Does not account for generic sequences (ie cursor and erase)
-// only for TextStyle sequences, AnsiSequences need further refinement
-template <class Stream, class Mutex>
-void
-AnsiStreamSink<Stream, Mutex>::filterSequences(const char_type * start, size_t size)
-{
-    constexpr char_type seqBegin = static_cast<char_type>(TextStyle::ESC);
-    constexpr char_type seqEnd = static_cast<char_type>(TextStyle::end);
-
-    const char_type * const last = start + size;
-
-    // start and end of the range to write (not of ansi sequences)
-    const char_type * beg = start;
-    const char_type * end = std::find(beg, last, seqBegin);
-    this->stream().write(beg, end - beg);
-
-    while (end != last)
-    {
-        beg = std::find(end, last, seqEnd);
-        beg++;
-
-        // start from end in case a sequence was missing a seqEnd
-        end = std::find(end + 1, last, seqBegin);
-
-        if (beg == last || beg > end)
-            throw sp::SpiritError{
-                "Missing an AnsiEscape termination or "
-                "unsupported sequence used in logging: {}",
-                start};
-
-        this->stream().write(beg, end - beg);
-    }
-}
-
 template <class Stream, class Mutex>
 void
 AnsiStreamSink<Stream, Mutex>::write(
@@ -138,10 +104,8 @@ AnsiStreamSink<Stream, Mutex>::write(
     size_t end
 )
 {
-    if (this->isAnsiEnabled())
-        this->stream().write(formatted.data() + start, end - start);
-    else
-        this->filterSequences(formatted.data() + start, end - start);
+    // escapes are stripped when ansi is disabled
+    this->writeText(formatted.data() + start, end - start);
 }
 
 
@@ -61,8 +61,12 @@
 
 #include "AnsiEscape.hpp"
 #include "AnsiStream.hpp"
+#include "AnsiStripBuf.hpp"
 
 #include "Format.hpp"
 #include "Logger.hpp"
+#include "ProgressGroup.hpp"
+#include "ScreenRenderer.hpp"
+#include "StatsReporter.hpp"
 
 #endif // SPIRIT_LOGGING_HPP
@@ -87,8 +87,9 @@ public:
         Args &&... args,
         SourceLocation loc = SourceLocation::current()
     )
-        : Base{sp::format(std::forward<Args>(args)...), loc}
+        : Base{loc}
     {
+        sp::formatTo(this->buffer(), std::forward<Args>(args)...);
     }
 
 };
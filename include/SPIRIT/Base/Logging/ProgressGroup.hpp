@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_PROGRESSGROUP_HPP
+#define SPIRIT_PROGRESSGROUP_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "SPIRIT/Base/Utils/Time/Clock.hpp"
+#include "AnsiStream.hpp"
+#include "Logger.hpp"
+#include "ScreenRenderer.hpp"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace sp
+{
+
+namespace details
+{
+
+// Each counter has its own cache line, workers never share them
+struct alignas(64) ProgressCounter
+{
+    std::atomic<sp::Uint64> value{0};
+    sp::Uint64 total = 0;
+    std::string label{};
+};
+
+} // namespace details
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Logging
+/// \brief Handle to a bar of a ProgressGroup
+///
+/// Updates are relaxed atomic operations on a counter owned by the bar,
+/// they never wait on the output. Handles can be copied freely and
+/// must not outlive their ProgressGroup.
+///
+////////////////////////////////////////////////////////////
+class SPIRIT_API ProgressBar
+{
+public:
+
+    ProgressBar() = default;
+
+    void
+    advance(sp::Uint64 n = 1)
+    {
+        counter->value.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void
+    set(sp::Uint64 value)
+    {
+        counter->value.store(value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] sp::Uint64
+    value() const
+    {
+        return counter->value.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] sp::Uint64
+    total() const
+    {
+        return counter->total;
+    }
+
+    [[nodiscard]] bool
+    isDone() const
+    {
+        return value() >= total();
+    }
+
+private:
+
+    friend class ProgressGroup;
+
+    explicit ProgressBar(details::ProgressCounter * counter) : counter{counter}
+    {
+    }
+
+    details::ProgressCounter * counter = nullptr;
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Logging
+/// \brief Multiple progress bars drawn by a single background thread
+///
+/// Worker threads only update their bar's counter, a renderer thread
+/// redraws the bars at most once per refresh period (see Clock) using a
+/// ScreenRenderer, so only what changed is output.
+///
+/// The bars are drawn below the cursor. Loggers writing to the same
+/// terminal should be attached: their records are then written in place of
+/// the bars, which are redrawn below the last log line.
+///
+/// When out is not an ansi terminal, only the final state is printed
+/// when the group is stopped.
+///
+/// \code
+/// sp::ProgressGroup progress{};
+/// progress.attach(sp::spiritLogger());
+///
+/// sp::ProgressBar bar = progress.addBar("Loading", nFiles);
+/// // from any thread:
+/// bar.advance();
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+class SPIRIT_API ProgressGroup
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Starts the renderer thread
+    ///
+    /// \param refreshPeriod Minimum time between two redraws
+    /// \param barWidth Number of cells of the bars themselves
+    ////////////////////////////////////////////////////////////
+    explicit ProgressGroup(
+        sp::AnsiFileStream & out             = sp::ansiOut,
+        sp::Clock::Nanoseconds refreshPeriod = std::chrono::milliseconds{100},
+        sp::Int32 barWidth                   = 40
+    );
+
+    ProgressGroup(const ProgressGroup &) = delete;
+    ProgressGroup &
+    operator=(const ProgressGroup &) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stops and detaches from all loggers
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ProgressGroup();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Adds a bar, displayed below the previous ones
+    ///
+    ////////////////////////////////////////////////////////////
+    ProgressBar
+    addBar(std::string label, sp::Uint64 total);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Makes the logger's records appear above the bars
+    ///
+    /// The first time a logger is attached (to any group), its sinks are
+    /// moved behind a sink which erases the bars before each record.
+    /// spdlog does not synchronize its sinks, this first attach must
+    /// happen before other threads log with the logger, or after.
+    ///
+    /// That sink stays in place: detach() and later attach() calls only
+    /// rebind it, they are safe while other threads log. Attaching an
+    /// attached logger has no effect, attaching it to a second group
+    /// moves it there.
+    ////////////////////////////////////////////////////////////
+    void
+    attach(const sp::LoggerPtr & logger);
+
+    void
+    detach(const sp::LoggerPtr & logger);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stops the renderer thread after drawing the final state
+    ///
+    /// The cursor is left on the line below the bars.
+    ////////////////////////////////////////////////////////////
+    void
+    stop();
+
+private:
+
+    class LogSink;
+
+    void
+    renderLoop();
+
+    // mutex must be held
+    void
+    draw();
+
+    void
+    drawBar(sp::Int32 row, const details::ProgressCounter & counter);
+
+    sp::AnsiFileStream & out;
+    sp::Int32 barWidth;
+
+    std::mutex mutex{};
+    std::deque<details::ProgressCounter> counters{};
+    sp::ScreenRenderer<sp::AnsiFileStream> screen;
+    sp::Int32 labelWidth = 0;
+
+    std::vector<std::shared_ptr<LogSink>> attached{};
+
+    sp::Clock clock;
+    std::atomic<bool> running{true};
+    std::thread renderer;
+};
+
+} // namespace sp
+
+
+#endif // SPIRIT_PROGRESSGROUP_HPP
@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_SCREENRENDERER_HPP
+#define SPIRIT_SCREENRENDERER_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "SPIRIT/Base/Utils/Time/Clock.hpp"
+#include "AnsiEscape.hpp"
+#include "AnsiStream.hpp"
+
+#include <string_view>
+#include <vector>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+/// \ingroup Logging
+/// \brief A character and its style, as displayed by a ScreenRenderer
+///
+////////////////////////////////////////////////////////////
+struct SPIRIT_API ScreenCell
+{
+    char ch        = ' ';
+    sp::FgColor fg = sp::defaultFg;
+    sp::BgColor bg = sp::onDefault;
+    sp::Style style = sp::reset; // no style
+
+    [[nodiscard]] bool
+    sameStyle(const ScreenCell & other) const
+    {
+        return fg.getColor() == other.fg.getColor()
+               && bg.getColor() == other.bg.getColor()
+               && style.getStyle() == other.style.getStyle();
+    }
+
+    friend bool
+    operator==(const ScreenCell & lhs, const ScreenCell & rhs)
+    {
+        return lhs.ch == rhs.ch && lhs.sameStyle(rhs);
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Logging
+/// \brief Double buffered renderer for live terminal displays
+///
+/// Drawing is done on a back buffer of cells which is compared to what
+/// is currently displayed (the front buffer) when presenting. Only the
+/// cells that changed are output, with cursor movements to skip the others
+/// and only the TextStyles needed between them.
+///
+/// By default, the region is drawn inline: it takes rows lines starting at
+/// the line of the cursor on the first present, and relative cursor movements
+/// are used from then on. anchorAt() instead draws the region at an absolute
+/// position on the screen.
+///
+/// The region must be narrower than the terminal, and drawn text should
+/// only contain printable characters. Inline regions expect no other output
+/// between presents, erase() them first.
+///
+/// \code
+/// sp::ScreenRenderer<> screen{sp::ansiOut, 2, 40};
+/// while (working)
+/// {
+///     screen.clear();
+///     screen.print(0, 0, sp::format("{:>3}%", percent), sp::green);
+///     screen.present(); // at most 30 times per second
+/// }
+/// \endcode
+///
+////////////////////////////////////////////////////////////
+template <class Stream = sp::AnsiFileStream>
+class ScreenRenderer
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Renders a rows x columns region to out, at most fps frames per second
+    ///
+    /// out should be an ansi aware stream (see AnsiStreamWrapper)
+    ////////////////////////////////////////////////////////////
+    ScreenRenderer(Stream & out, sp::Int32 rows, sp::Int32 columns, float fps = 30.f);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the region at an absolute position (1, 1 is the top left corner)
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    anchorAt(sp::Int32 line, sp::Int32 column);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Changes the size of the region, the back buffer is cleared
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    resize(sp::Int32 rows, sp::Int32 columns);
+
+    [[nodiscard]] sp::Int32
+    rows() const
+    {
+        return nRows;
+    }
+
+    [[nodiscard]] sp::Int32
+    columns() const
+    {
+        return nColumns;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Limits how often present() outputs, 0 is unlimited
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    setFps(float fps)
+    {
+        clock.setFps(fps);
+    }
+
+    [[nodiscard]] float
+    getFps() const
+    {
+        return clock.getFps();
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Fills the back buffer with empty cells
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    clear(ScreenCell fill = ScreenCell{});
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Sets a cell of the back buffer, out of bounds cells are ignored
+    ///
+    /// row and column are 0 based, from the top left of the region.
+    ////////////////////////////////////////////////////////////
+    void
+    put(sp::Int32 row, sp::Int32 column, ScreenCell cell);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Writes text in the back buffer, clipped to the region
+    ///
+    /// \return The number of cells written
+    ////////////////////////////////////////////////////////////
+    sp::Int32
+    print(
+        sp::Int32 row,
+        sp::Int32 column,
+        std::string_view text,
+        sp::FgColor fg  = sp::defaultFg,
+        sp::BgColor bg  = sp::onDefault,
+        sp::Style style = sp::reset
+    );
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Cell of the back buffer, must be in bounds
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] const ScreenCell &
+    cell(sp::Int32 row, sp::Int32 column) const
+    {
+        return back[index(row, column)];
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Outputs the changes if a frame is due
+    ///
+    /// \return true if the frame was presented
+    ////////////////////////////////////////////////////////////
+    bool
+    present();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Outputs the changes, regardless of the frame rate
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    presentNow();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief The next present will redraw all cells
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    invalidate()
+    {
+        frontValid = false;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Erases the region from the terminal
+    ///
+    /// For inline regions, the cursor is left at the start of the region
+    /// so that other output takes its place. The next present draws
+    /// the region again from the cursor's line.
+    ////////////////////////////////////////////////////////////
+    void
+    erase();
+
+private:
+
+    [[nodiscard]] std::size_t
+    index(sp::Int32 row, sp::Int32 column) const
+    {
+        return static_cast<std::size_t>(row) * nColumns + column;
+    }
+
+    void
+    redraw();
+
+    void
+    moveTo(sp::Int32 row, sp::Int32 column);
+
+    void
+    putCell(const ScreenCell & cell);
+
+    void
+    resetStyle();
+
+    Stream & out;
+
+    sp::Int32 nRows;
+    sp::Int32 nColumns;
+
+    std::vector<ScreenCell> front{};
+    std::vector<ScreenCell> back{};
+    bool frontValid = false;
+
+    // the region is on the terminal (inline regions take lines once drawn)
+    bool drawn = false;
+
+    bool absolute = false;
+    sp::Int32 originLine = 1;
+    sp::Int32 originColumn = 1;
+
+    // position of the cursor in the region, and the style it writes with
+    sp::Int32 cursorRow    = 0;
+    sp::Int32 cursorColumn = 0;
+    ScreenCell cursorStyle{};
+
+    sp::WindowClock clock{};
+};
+
+} // namespace sp
+
+
+#include "ScreenRenderer_inl.hpp"
+
+#endif // SPIRIT_SCREENRENDERER_HPP
@@ -0,0 +1,330 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_SCREENRENDERER_INL_HPP
+#define SPIRIT_SCREENRENDERER_INL_HPP
+
+#include "ScreenRenderer.hpp"
+
+#include <algorithm>
+
+namespace sp
+{
+
+template <class Stream>
+ScreenRenderer<Stream>::ScreenRenderer(
+    Stream & out,
+    sp::Int32 rows,
+    sp::Int32 columns,
+    float fps
+)
+    : out{out}, nRows{rows}, nColumns{columns}
+{
+    resize(rows, columns);
+    setFps(fps);
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::anchorAt(sp::Int32 line, sp::Int32 column)
+{
+    erase();
+
+    absolute     = true;
+    originLine   = line;
+    originColumn = column;
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::resize(sp::Int32 rows, sp::Int32 columns)
+{
+    erase();
+
+    nRows    = std::max(rows, 0);
+    nColumns = std::max(columns, 0);
+
+    back.assign(static_cast<std::size_t>(nRows) * nColumns, ScreenCell{});
+    front = back;
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::clear(ScreenCell fill)
+{
+    std::fill(back.begin(), back.end(), fill);
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::put(sp::Int32 row, sp::Int32 column, ScreenCell cell)
+{
+    if (0 <= row && row < nRows && 0 <= column && column < nColumns)
+        back[index(row, column)] = cell;
+}
+
+template <class Stream>
+sp::Int32
+ScreenRenderer<Stream>::print(
+    sp::Int32 row,
+    sp::Int32 column,
+    std::string_view text,
+    sp::FgColor fg,
+    sp::BgColor bg,
+    sp::Style style
+)
+{
+    if (row < 0 || row >= nRows || column >= nColumns)
+        return 0;
+
+    sp::Int32 written = 0;
+    for (char ch : text)
+    {
+        if (column >= nColumns)
+            break;
+
+        if (column >= 0)
+        {
+            back[index(row, column)] = ScreenCell{ch, fg, bg, style};
+            ++written;
+        }
+        ++column;
+    }
+
+    return written;
+}
+
+template <class Stream>
+bool
+ScreenRenderer<Stream>::present()
+{
+    bool isDue = clock.getCurrentDt() >= clock.getMinimumTickPeriod();
+
+    // Invalid frames are never delayed, the display would be stale
+    if (!isDue && frontValid)
+        return false;
+
+    if (isDue)
+        clock.tick(); // does not wait, the period has elapsed
+
+    presentNow();
+    return true;
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::presentNow()
+{
+    // The cursor may have been moved by other output
+    if (absolute)
+        cursorRow = -1;
+
+    if (!frontValid)
+        redraw();
+    else
+    {
+        for (sp::Int32 row = 0; row < nRows; ++row)
+        {
+            for (sp::Int32 column = 0; column < nColumns; ++column)
+            {
+                std::size_t i = index(row, column);
+                if (back[i] == front[i])
+                    continue;
+
+                moveTo(row, column);
+                putCell(back[i]);
+                front[i] = back[i];
+            }
+        }
+    }
+
+    resetStyle();
+    if (!absolute && nRows > 0)
+        moveTo(nRows - 1, 0);
+
+    out << std::flush;
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::erase()
+{
+    if (drawn)
+    {
+        resetStyle();
+
+        if (absolute)
+        {
+            for (sp::Int32 row = 0; row < nRows; ++row)
+            {
+                out << sp::MoveCursorTo{originLine + row, originColumn};
+                for (sp::Int32 column = 0; column < nColumns; ++column)
+                    out << ' ';
+            }
+        }
+        else
+        {
+            moveTo(0, 0);
+            out << sp::EraseCursorToEndScreen{};
+        }
+
+        out << std::flush;
+    }
+
+    drawn      = false;
+    frontValid = false;
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::redraw()
+{
+    if (!absolute)
+    {
+        if (drawn)
+            moveTo(0, 0);
+        else
+            out << sp::CarriageRet{};
+
+        cursorRow    = 0;
+        cursorColumn = 0;
+    }
+
+    for (sp::Int32 row = 0; row < nRows; ++row)
+    {
+        if (absolute)
+            out << sp::MoveCursorTo{originLine + row, originColumn};
+        else if (row > 0)
+            out << sp::CarriageRet{} << '\n';
+
+        cursorRow    = row;
+        cursorColumn = 0;
+
+        for (sp::Int32 column = 0; column < nColumns; ++column)
+            putCell(back[index(row, column)]);
+
+        if (!absolute)
+        {
+            // Erasing fills with the current background color
+            resetStyle();
+            out << sp::EraseCursorToEndLine{};
+        }
+    }
+
+    front      = back;
+    frontValid = true;
+    drawn      = true;
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::moveTo(sp::Int32 row, sp::Int32 column)
+{
+    if (row == cursorRow && column == cursorColumn)
+        return;
+
+    if (row == cursorRow && column > cursorColumn)
+    {
+        // Rewriting a few unchanged cells is shorter than a cursor movement
+        constexpr sp::Int32 maxRewrite = 3;
+        bool rewrite = column - cursorColumn <= maxRewrite;
+        for (sp::Int32 c = cursorColumn; rewrite && c < column; ++c)
+            rewrite = front[index(row, c)].sameStyle(cursorStyle);
+
+        if (rewrite)
+        {
+            for (sp::Int32 c = cursorColumn; c < column; ++c)
+                out << front[index(row, c)].ch;
+        }
+        else
+            out << sp::CursorRight{column - cursorColumn};
+    }
+    else if (absolute)
+    {
+        out << sp::MoveCursorTo{originLine + row, originColumn + column};
+    }
+    else
+    {
+        if (row < cursorRow)
+            out << sp::CursorUp{cursorRow - row};
+        else if (row > cursorRow)
+            out << sp::CursorDown{row - cursorRow};
+
+        if (column == 0 && cursorColumn != 0)
+            out << sp::CarriageRet{};
+        else if (column > cursorColumn)
+            out << sp::CursorRight{column - cursorColumn};
+        else if (column < cursorColumn)
+            out << sp::CursorToColumn{column + 1};
+    }
+
+    cursorRow    = row;
+    cursorColumn = column;
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::putCell(const ScreenCell & cell)
+{
+    if (!cell.sameStyle(cursorStyle))
+    {
+        // Modifiers can only be removed by a reset
+        if (cell.style.getStyle() != cursorStyle.style.getStyle())
+        {
+            resetStyle();
+            if (cell.style.getStyle() != sp::Style::reset)
+                out << cell.style;
+        }
+
+        if (cell.fg.getColor() != cursorStyle.fg.getColor())
+            out << cell.fg;
+
+        if (cell.bg.getColor() != cursorStyle.bg.getColor())
+            out << cell.bg;
+
+        cursorStyle    = cell;
+        cursorStyle.ch = ' ';
+    }
+
+    out << cell.ch;
+    ++cursorColumn;
+}
+
+template <class Stream>
+void
+ScreenRenderer<Stream>::resetStyle()
+{
+    if (!cursorStyle.sameStyle(ScreenCell{}))
+    {
+        out << sp::reset;
+        cursorStyle = ScreenCell{};
+    }
+}
+
+} // namespace sp
+
+
+#endif // SPIRIT_SCREENRENDERER_INL_HPP
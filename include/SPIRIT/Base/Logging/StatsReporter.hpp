@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_STATSREPORTER_HPP
+#define SPIRIT_STATSREPORTER_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "SPIRIT/Base/Utils/Time/Clock.hpp"
+#include "SPIRIT/Base/Utils/Time/Histogram.hpp"
+#include "Logger.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+/// \ingroup Logging
+/// \brief Event counter incremented concurrently
+///
+/// add() is a relaxed atomic increment of the calling thread's shard,
+/// each shard has its own cache line so threads don't contend.
+/// read() sums the shards.
+///
+////////////////////////////////////////////////////////////
+class SPIRIT_API Counter
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief nShards defaults to the number of hardware threads
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit Counter(std::size_t nShards = 0);
+
+    Counter(const Counter &) = delete;
+
+    Counter &
+    operator=(const Counter &) = delete;
+
+    void
+    add(sp::Uint64 n = 1)
+    {
+        shards[details::threadShardIndex() % nShards].value.fetch_add(
+            n,
+            std::memory_order_relaxed
+        );
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Total of all additions
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] sp::Uint64
+    read() const;
+
+private:
+
+    struct alignas(64) Shard
+    {
+        std::atomic<sp::Uint64> value{0};
+    };
+
+    std::size_t nShards;
+    std::unique_ptr<Shard[]> shards;
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Logging
+/// \brief Periodically logs registered statistics as a single record
+///
+/// A background thread logs a record every period, such as:
+/// \code
+/// Stats over 10.00s: requests 12034 (1203.40/s), queue 3, latency n=12034 p50 1.20ms p99 4.10ms max 9.87ms
+/// \endcode
+///
+/// - Counters report their increase over the period and its rate.
+/// - Gauges report their current value.
+/// - Histograms report the durations recorded during the period,
+///   they are reset on each record (see Histogram::snapshot).
+///
+/// Instrumented code only increments Counters and records in Histograms,
+/// formatting and logging are done by the reporter's thread.
+///
+/// \code
+/// sp::Counter requests{};
+/// sp::Histogram latency{};
+///
+/// sp::StatsReporter stats{sp::spiritLogger(), std::chrono::seconds{10}};
+/// stats.addCounter("requests", requests);
+/// stats.addGauge("queue", [&]() { return queue.size(); });
+/// stats.addHistogram("latency", latency);
+///
+/// // in the hot path:
+/// requests.add();
+/// latency.record(timer);
+/// \endcode
+///
+/// Registered Counters, Histograms and callbacks must outlive the
+/// reporter or be removed first.
+///
+////////////////////////////////////////////////////////////
+class SPIRIT_API StatsReporter
+{
+public:
+
+    typedef std::function<sp::Uint64()> CounterCallback; // running total
+    typedef std::function<double()> GaugeCallback;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Starts the reporting thread
+    ///
+    /// \param period Time between two records
+    ////////////////////////////////////////////////////////////
+    explicit StatsReporter(
+        sp::LoggerPtr logger          = sp::spiritLogger(),
+        sp::Clock::Nanoseconds period = std::chrono::seconds{10},
+        sp::LogLevel level            = sp::LogLevel::info
+    );
+
+    StatsReporter(const StatsReporter &) = delete;
+
+    StatsReporter &
+    operator=(const StatsReporter &) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stops without logging a last record
+    ///
+    ////////////////////////////////////////////////////////////
+    ~StatsReporter();
+
+    void
+    addCounter(std::string name, const Counter & counter);
+
+    void
+    addCounter(std::string name, CounterCallback total);
+
+    void
+    addGauge(std::string name, GaugeCallback gauge);
+
+    void
+    addHistogram(std::string name, Histogram & histogram);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Removes the statistics registered under name
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    remove(std::string_view name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Builds the record for the time since the previous one
+    ///
+    /// This starts a new period, the reporting thread uses it.
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::string
+    collect();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Logs a record now, the next one is a period later
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    reportNow();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stops the reporting thread: wakes it without waiting for
+    /// the rest of the period, then joins it
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    stop();
+
+private:
+
+    struct CounterStat
+    {
+        CounterCallback total;
+        sp::Uint64 last;
+    };
+
+    struct GaugeStat
+    {
+        GaugeCallback value;
+    };
+
+    struct HistogramStat
+    {
+        Histogram * histogram;
+    };
+
+    struct Stat
+    {
+        std::string name;
+        std::variant<CounterStat, GaugeStat, HistogramStat> stat;
+    };
+
+    sp::Clock::Nanoseconds
+    sinceRecord();
+
+    void
+    reportLoop();
+
+    sp::LoggerPtr logger;
+    sp::LogLevel level;
+    sp::Clock::Nanoseconds period;
+
+    std::mutex mutex{};
+    std::vector<Stat> stats{};
+    sp::Clock clock{}; // measures the time since the last record
+
+    std::mutex stopMutex{};
+    std::condition_variable stopped{};
+    bool running = true;
+    std::thread reporter;
+};
+
+} // namespace sp
+
+
+#endif // SPIRIT_STATSREPORTER_HPP
@@ -32,6 +32,7 @@
 #include <cmath>
 #include <iostream>
 #include <sstream>
+#include <string_view>
 
 namespace sp
 {
@@ -86,7 +87,7 @@ protected:
 
     template <sp::Int32 nCodes>
     static std::ostream &
-    putCodes(std::ostream & os, sp::Int32 (&codes)[nCodes])
+    putCodes(std::ostream & os, const sp::Int32 (&codes)[nCodes])
     {
         os << CSI;
         for (sp::Int32 i = 0; i < nCodes - 1; ++i) os << codes[i] << ";";
@@ -101,6 +102,33 @@ class SPIRIT_API TerminalControl : public AnsiEscape
 };
 
 
+namespace details
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Parameters of a single "CSI [params] m" sequence
+///
+/// TextStyles that are made of a single sequence expose them with
+/// sgrParams(), which lets ansi streams track the current text style
+/// without having to parse what the escape outputs.
+///
+////////////////////////////////////////////////////////////
+struct SgrParams
+{
+    static constexpr sp::Int32 maxParams = 5;
+
+    sp::Int32 codes[maxParams]{};
+    sp::Int32 size = 0;
+};
+
+// Marks sp::Escapes, which are streamed one contained escape at a time
+struct EscapesPack
+{
+};
+
+} // namespace details
+
+
 namespace traits
 {
 
@@ -143,6 +171,52 @@ template <class... Args>
 using EscapeType = typename sp::traits::
     Bases<sp::AnsiEscape, sp::TextStyle, sp::TerminalControl>::DeepestOf<Args...>;
 
+
+////////////////////////////////////////////////////////////
+/// \ingroup Concepts
+/// \brief TextStyles made of a single sequence, exposing sgrParams()
+///
+////////////////////////////////////////////////////////////
+template <class T, class = void>
+struct hasSgrParams : public std::false_type
+{
+};
+
+template <class T>
+struct hasSgrParams<T, void_t<decltype(std::declval<const T &>().sgrParams())>>
+    : public std::true_type
+{
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Concepts
+/// \brief TextStyles that are pre-rendered text containing escapes (gradients)
+///
+////////////////////////////////////////////////////////////
+template <class T, class = void>
+struct hasRenderedText : public std::false_type
+{
+};
+
+template <class T>
+struct hasRenderedText<T, void_t<decltype(std::declval<const T &>().str())>>
+    : public std::true_type
+{
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Concepts
+/// \brief Combined escapes (sp::Escapes and derived classes)
+///
+////////////////////////////////////////////////////////////
+template <class T>
+struct isEscapesPack
+    : public std::is_base_of<sp::details::EscapesPack, std::remove_cvref_t<T>>
+{
+};
+
 } // namespace traits
 
 
@@ -191,10 +265,17 @@ public:
         return t;
     }
 
+
+    [[nodiscard]] constexpr SgrParams
+    sgrParams() const
+    {
+        return SgrParams{{(sp::Int32)t * 10 + c}, 1};
+    }
+
     friend std::ostream &
     operator<<(std::ostream & os, AnsiColor color)
     {
-        return TextStyle::putCode(os, (sp::Int32)color.t * 10 + color.c);
+        return TextStyle::putCode(os, color.sgrParams().codes[0]);
     }
 
 
@@ -222,17 +303,18 @@ public:
     sp::Uint8 b;
 
 
+    [[nodiscard]] constexpr SgrParams
+    sgrParams() const
+    {
+        return SgrParams{
+            {(sp::Int32)t * 10 + declareRgbColor, declareRgbSequence, r, g, b},
+            5};
+    }
+
     friend std::ostream &
     operator<<(std::ostream & os, AnsiRgbColor c)
     {
-        sp::Int32 codes[5]{
-            (sp::Int32)t * 10 + c.declareRgbColor,
-            c.declareRgbSequence,
-            c.r,
-            c.g,
-            c.b};
-
-        return TextStyle::putCodes(os, codes);
+        return TextStyle::putCodes(os, c.sgrParams().codes);
     }
 
 
@@ -298,6 +380,15 @@ public:
     }
 
 
+    ////////////////////////////////////////////////////////////
+    /// \brief The rendered text, with its color escapes
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] std::string_view
+    str() const
+    {
+        return txt;
+    }
+
     friend std::ostream &
     operator<<(std::ostream & os, const AnsiGradient & grad)
     {
@@ -358,6 +449,20 @@ public:
     constexpr AnsiStyle(style mod) : mod{mod} {}
 
 
+    [[nodiscard]] constexpr style
+    getStyle() const
+    {
+        return mod;
+    }
+
+
+    [[nodiscard]] constexpr SgrParams
+    sgrParams() const
+    {
+        return SgrParams{{mod}, 1};
+    }
+
+
     friend std::ostream &
     operator<<(std::ostream & os, AnsiStyle mod)
     {
@@ -0,0 +1,166 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_ANSISTRIPPER_HPP
+#define SPIRIT_ANSISTRIPPER_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "AnsiEscapeImpl.hpp"
+
+#include <algorithm>
+#include <ios>
+
+namespace sp
+{
+namespace details
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Incremental parser that removes ansi escapes from text
+///
+/// Text is given in chunks, a sequence may be split across chunks
+/// (the parsing state is kept between calls).
+///
+/// Recognizes CSI sequences (ESC [ ... final), string sequences
+/// (ESC ] / P / X / ^ / _ ... terminated by BEL or ESC \)
+/// and two character escapes (ESC [intermediates] final).
+///
+/// Text outside of sequences is handed out as ranges of the input,
+/// it is never copied.
+///
+////////////////////////////////////////////////////////////
+template <class char_type>
+class AnsiStripper
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Calls write(const char_type *, std::streamsize) for each
+    /// run of text that is not part of an escape
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class Write>
+    void
+    strip(const char_type * str, std::streamsize n, Write && write)
+    {
+        constexpr char_type esc = static_cast<char_type>(AnsiEscape::ESC);
+
+        const char_type * cur        = str;
+        const char_type * const last = str + n;
+
+        while (cur != last)
+        {
+            if (current == ground)
+            {
+                const char_type * seq = std::find(cur, last, esc);
+                if (seq != cur)
+                    write(cur, seq - cur);
+
+                if (seq == last)
+                    return;
+
+                current = escape;
+                cur     = seq + 1;
+            }
+            else
+                current = next(current, *cur++);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief true if the last chunk ended inside of an escape
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool
+    inSequence() const
+    {
+        return current != ground;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Drops a partially parsed escape
+    ////////////////////////////////////////////////////////////
+    void
+    reset()
+    {
+        current = ground;
+    }
+
+private:
+
+    enum state : sp::Uint8
+    {
+        ground,
+        escape,
+        escapeIntermediate,
+        csi,
+        string,
+        stringEscape
+    };
+
+    static constexpr state
+    next(state s, char_type c)
+    {
+        sp::Int64 ch = static_cast<sp::Int64>(c);
+        switch (s)
+        {
+        case escape:
+            if (ch == '[')
+                return csi;
+            if (ch == ']' || ch == 'P' || ch == 'X' || ch == '^' || ch == '_')
+                return string;
+            if (ch == AnsiEscape::ESC)
+                return escape;
+            [[fallthrough]];
+
+        case escapeIntermediate:
+            return (ch >= 0x20 && ch <= 0x2F) ? escapeIntermediate : ground;
+
+        case csi:
+            // parameters and intermediates are in [0x20, 0x3F]
+            return (ch >= 0x40 && ch <= 0x7E) ? ground : csi;
+
+        case string:
+            if (ch == '\a')
+                return ground;
+            return ch == AnsiEscape::ESC ? stringEscape : string;
+
+        case stringEscape:
+            if (ch == '\\')
+                return ground;
+            return ch == AnsiEscape::ESC ? stringEscape : string;
+
+        default: return ground;
+        }
+    }
+
+    state current = ground;
+};
+
+} // namespace details
+} // namespace sp
+
+
+#endif // SPIRIT_ANSISTRIPPER_HPP
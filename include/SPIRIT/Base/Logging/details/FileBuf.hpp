@@ -28,14 +28,21 @@
 
 #include "SPIRIT/Base/Configuration/config.hpp"
 #include <array>
+#include <atomic>
 #include <stdio.h>
 #include <streambuf>
+#include <string_view>
 
 namespace sp
 {
 namespace details
 {
 
+// Removes buf from the crash handler's registry, see sp::registerCrashFlush
+SPIRIT_API void
+forgetCrashFlush(const void * buf) noexcept;
+
+
 template <typename char_type>
 class FileBufBase : public std::basic_streambuf<char_type>
 {
@@ -58,6 +65,19 @@ public:
         return targetFile;
     }
 
+    // Output that was not yet written to the file
+    std::basic_string_view<char_type>
+    pendingOutput() const noexcept
+    {
+        return {
+            this->pbase(),
+            static_cast<std::size_t>(this->pptr() - this->pbase())};
+    }
+
+    // Set by sp::registerCrashFlush, the buffer unregisters itself when
+    // destroyed so that the crash handler never reads a dangling buffer
+    std::atomic<bool> isCrashFlushed{false};
+
 protected:
 
     ////////////////////////////////////////////////////////////
@@ -294,7 +314,12 @@ public:
         this->setg(io.in.buf.begin(), io.in.buf.end(), io.in.buf.end());
     }
 
-    ~FileBuf() override = default;
+    ~FileBuf() override
+    {
+        // before io is destroyed, the crash handler may read it until then
+        if (this->isCrashFlushed.load())
+            sp::details::forgetCrashFlush(this);
+    }
 
 protected:
 
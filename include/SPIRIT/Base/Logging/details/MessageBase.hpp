@@ -30,6 +30,8 @@
 #include "SPIRIT/Base/Logging/Format.hpp"
 #include "spdlog/logger.h"
 
+#include <string_view>
+
 
 #if __has_include(<source_location>)
 #    include <source_location>
@@ -47,6 +49,12 @@ using LogLevel = spdlog::level::level_enum;
 namespace details
 {
 
+////////////////////////////////////////////////////////////
+// Text and source location of a Message
+//
+// The text is formatted in an inline buffer, only messages longer
+// than inlineCapacity allocate.
+////////////////////////////////////////////////////////////
 template <LogLevel lvl>
 class MessageBase
 {
@@ -58,45 +66,81 @@ public:
     typedef std::experimental::source_location SourceLocation;
 #endif
 
+    static constexpr std::size_t inlineCapacity = 256;
+
+    typedef fmt::basic_memory_buffer<char, inlineCapacity> Buffer;
+
+
+    MessageBase(std::string_view str, SourceLocation loc) : loc{loc}
+    {
+        msg.append(str.data(), str.data() + str.size());
+    }
 
-    MessageBase(std::string && str, SourceLocation loc)
-        : msg{std::move(str)}, loc{loc}
+    MessageBase(const MessageBase & other)
+        : MessageBase{other.str(), other.sourceLoc()}
     {
     }
 
     template <LogLevel otherLevel>
     MessageBase(const MessageBase<otherLevel> & other)
-        : loc{other.loc}, msg{other.msg} {};
+        : MessageBase{other.str(), other.sourceLoc()}
+    {
+    }
+
+    MessageBase(MessageBase && other) noexcept
+        : loc{other.loc}, msg{std::move(other.msg)}
+    {
+    }
 
     template <LogLevel otherLevel>
-    MessageBase(MessageBase<otherLevel> && other)
-        : loc{other.loc}, msg{std::move(other.msg)} {};
+    MessageBase(MessageBase<otherLevel> && other) noexcept
+        : loc{other.loc}, msg{std::move(other.msg)}
+    {
+    }
 
+    MessageBase &
+    operator=(const MessageBase & other)
+    {
+        return this->operator=<lvl>(other);
+    }
 
     template <LogLevel otherLevel>
     MessageBase &
     operator=(const MessageBase<otherLevel> & other)
     {
-        loc = other.loc;
-        msg = other.msg;
+        if (static_cast<const void *>(this) != &other)
+        {
+            loc = other.sourceLoc();
+            msg.clear();
+            msg.append(other.str().data(), other.str().data() + other.str().size());
+        }
         return *this;
-    };
+    }
+
+    MessageBase &
+    operator=(MessageBase && other) noexcept
+    {
+        return this->operator=<lvl>(std::move(other));
+    }
 
     template <LogLevel otherLevel>
     MessageBase &
-    operator=(MessageBase<otherLevel> && other)
+    operator=(MessageBase<otherLevel> && other) noexcept
     {
-        std::swap(loc, other.loc);
-        std::swap(msg, other.msg);
+        if (static_cast<const void *>(this) != &other)
+        {
+            loc = other.loc;
+            msg = std::move(other.msg);
+        }
         return *this;
-    };
+    }
 
     ~MessageBase() = default;
 
-    [[nodiscard]] const std::string &
+    [[nodiscard]] std::string_view
     str() const
     {
-        return msg;
+        return {msg.data(), msg.size()};
     }
 
     [[nodiscard]] const SourceLocation &
@@ -108,21 +152,36 @@ public:
     friend spdlog::logger &
     operator<<(spdlog::logger & logger, const MessageBase & msg)
     {
+        // string_view_t is logged as is, without another formatting pass
         logger.log(
             spdlog::source_loc{
                 msg.sourceLoc().file_name(),
                 static_cast<int>(msg.sourceLoc().line()),
                 msg.sourceLoc().function_name()},
             lvl,
-            msg.str().c_str()
+            spdlog::string_view_t{msg.msg.data(), msg.msg.size()}
         );
         return logger;
     }
 
+protected:
+
+    // Messages format their arguments directly in msg
+    explicit MessageBase(SourceLocation loc) : loc{loc} {}
+
+    Buffer &
+    buffer()
+    {
+        return msg;
+    }
+
 private:
 
+    template <LogLevel>
+    friend class MessageBase;
+
     SourceLocation loc;
-    std::string msg;
+    Buffer msg{};
 };
 
 
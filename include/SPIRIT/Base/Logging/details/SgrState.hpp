@@ -0,0 +1,246 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_SGRSTATE_HPP
+#define SPIRIT_SGRSTATE_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "AnsiEscapeImpl.hpp"
+
+#include <algorithm>
+#include <ios>
+
+namespace sp
+{
+namespace details
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Current text style of a terminal, as set by SGR sequences
+///
+/// SGR (Select Graphic Rendition) sequences are the "CSI [params] m"
+/// escapes that TextStyles are made of.
+///
+/// Applying a sequence tells if it changed anything, sequences that do not
+/// can be dropped from the output.
+///
+/// The state may become unknown (unsupported parameters, text written
+/// behind our back, ...), then every sequence is considered to change it
+/// until a complete reset is applied.
+///
+////////////////////////////////////////////////////////////
+class SPIRIT_API SgrState
+{
+public:
+
+    // Longer sequences are written as is and make the state unknown
+    static constexpr sp::Int32 maxParams = 16;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Applies the parameters of a single SGR sequence
+    ///
+    /// An empty parameter list is a reset.
+    ///
+    /// \return true if the sequence must be output
+    ////////////////////////////////////////////////////////////
+    bool
+    apply(const sp::Int32 * params, sp::Int32 nParams);
+
+    bool
+    apply(const sp::details::SgrParams & params)
+    {
+        return apply(params.codes, params.size);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Forget the current state, until the next reset
+    ////////////////////////////////////////////////////////////
+    void
+    invalidate()
+    {
+        known = false;
+    }
+
+    [[nodiscard]] bool
+    isKnown() const
+    {
+        return known;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief true if no style or color is applied
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool
+    isDefault() const
+    {
+        return known && *this == SgrState{};
+    }
+
+    friend bool
+    operator==(const SgrState & lhs, const SgrState & rhs) = default;
+
+private:
+
+    // Colors are packed as (kind << 24 | value), 0 is the default color
+    enum colorKind : sp::Uint32
+    {
+        defaultColor = 0,
+        basicColor   = 1, // value is the 30-37 / 90-97 code
+        paletteColor = 2, // value is the 256 colors index
+        rgbColor     = 3  // value is 0xRRGGBB
+    };
+
+    static constexpr sp::Uint32
+    packColor(colorKind kind, sp::Uint32 value)
+    {
+        return (static_cast<sp::Uint32>(kind) << 24) | (value & 0xFFFFFF);
+    }
+
+    // Reads an extended color (38/48;5;n or 38/48;2;r;g;b) starting after
+    // the 38/48 code, returns the number of params consumed or -1.
+    static sp::Int32
+    readExtendedColor(
+        const sp::Int32 * params,
+        sp::Int32 nParams,
+        sp::Uint32 & color
+    );
+
+    void
+    applyCode(sp::Int32 code);
+
+    sp::Uint32 fg = 0;
+    sp::Uint32 bg = 0;
+
+    // bit i set when modifier i (1-9, 21) is on
+    sp::Uint32 modifiers = 0;
+    // 0 is the default font, fonts 11-20 are 1-10
+    sp::Uint8 font = 0;
+
+    bool known = true;
+};
+
+
+////////////////////////////////////////////////////////////
+/// \brief Writes text which may contain ansi escapes to os
+///
+/// SGR sequences update state, and only the ones that change it are written.
+/// Other characters and escapes are written as is.
+///
+/// Sequences are expected to be complete, a truncated sequence is
+/// written and makes the state unknown.
+////////////////////////////////////////////////////////////
+template <class char_type, class OutStream>
+void
+writeTracked(
+    OutStream & os,
+    SgrState & state,
+    const char_type * str,
+    std::streamsize n
+)
+{
+    constexpr char_type esc = static_cast<char_type>(AnsiEscape::ESC);
+
+    const char_type * cur        = str;
+    const char_type * const last = str + n;
+
+    while (cur != last)
+    {
+        const char_type * seq = std::find(cur, last, esc);
+        os.write(cur, seq - cur);
+        if (seq == last)
+            return;
+
+        // ESC [ params m
+        const char_type * it = seq + 1;
+        if (it == last || *it != static_cast<char_type>('['))
+        {
+            // not a CSI, let the terminal deal with it
+            os.write(seq, it - seq);
+            cur = it;
+            continue;
+        }
+        ++it;
+
+        sp::Int32 params[SgrState::maxParams]{};
+        sp::Int32 nParams  = 0;
+        bool tooManyParams = false;
+        bool hasParams     = false;
+        for (; it != last; ++it)
+        {
+            char_type c = *it;
+            if (c >= static_cast<char_type>('0') && c <= static_cast<char_type>('9'))
+            {
+                if (nParams < SgrState::maxParams)
+                    params[nParams] = params[nParams] * 10 + (c - '0');
+                hasParams = true;
+            }
+            else if (c == static_cast<char_type>(';'))
+            {
+                tooManyParams |= ++nParams >= SgrState::maxParams;
+                hasParams = true; // "CSI ; m" has two (empty) params
+            }
+            else
+                break;
+        }
+        if (hasParams)
+            ++nParams;
+
+        // CSI sequences end with a byte in [0x40, 0x7E]
+        while (it != last
+               && (*it < static_cast<char_type>(0x40)
+                   || *it > static_cast<char_type>(0x7E)))
+            ++it;
+
+        if (it == last)
+        {
+            os.write(seq, last - seq);
+            state.invalidate();
+            return;
+        }
+
+        bool isSgr = *it == static_cast<char_type>(TextStyle::end);
+        ++it;
+
+        if (!isSgr)
+            os.write(seq, it - seq);
+        else if (tooManyParams)
+        {
+            os.write(seq, it - seq);
+            state.invalidate();
+        }
+        else if (state.apply(params, nParams))
+            os.write(seq, it - seq);
+
+        cur = it;
+    }
+}
+
+
+} // namespace details
+} // namespace sp
+
+
+#endif // SPIRIT_SGRSTATE_HPP
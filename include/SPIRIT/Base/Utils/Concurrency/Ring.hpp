@@ -0,0 +1,358 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_RING_HPP
+#define SPIRIT_RING_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+/// \ingroup Base
+/// \defgroup Concurrency Concurrency
+///
+/// \brief Queues for handing data between threads
+///
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Concurrency
+/// \brief Wait-free bounded queue for one producer and one consumer thread
+///
+/// The capacity is rounded up to a power of two. Each side keeps its
+/// index on its own cache line, along with a copy of the other side's
+/// index that it only refreshes when the ring looks full (or empty).
+///
+/// The try functions never wait. When isBlocking is true, push() and pop()
+/// also wait for room (or elements) with std::atomic::wait, at the cost
+/// of a fence per operation to detect sleeping threads.
+///
+////////////////////////////////////////////////////////////
+template <class T, bool isBlocking = false>
+class SpscRing
+{
+public:
+
+    typedef T value_type;
+
+    explicit SpscRing(std::size_t minCapacity);
+
+    SpscRing(const SpscRing &) = delete;
+
+    SpscRing &
+    operator=(const SpscRing &) = delete;
+
+    ~SpscRing();
+
+    ////////////////////////////////////////////////////////////
+    // Producer
+    ////////////////////////////////////////////////////////////
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructs an element at the back, false when full
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class... Args>
+    bool
+    tryEmplace(Args &&... args);
+
+    bool
+    tryPush(const T & value)
+    {
+        return tryEmplace(value);
+    }
+
+    bool
+    tryPush(T && value)
+    {
+        return tryEmplace(std::move(value));
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pushes as much of [start, finish) as fits, publishes once
+    ///
+    /// \return an iterator to the first element that was not pushed
+    ///
+    ////////////////////////////////////////////////////////////
+    template <std::forward_iterator Iter>
+    Iter
+    tryPushBatch(Iter start, Iter finish);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Waits for room, then pushes
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class U>
+    void
+    push(U && value)
+        requires isBlocking;
+
+    ////////////////////////////////////////////////////////////
+    // Consumer
+    ////////////////////////////////////////////////////////////
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Moves the front element into out, false when empty
+    ///
+    ////////////////////////////////////////////////////////////
+    bool
+    tryPop(T & out);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Moves up to maxCount elements to out, publishes once
+    ///
+    /// \return the number of elements popped
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class OutputIter>
+    std::size_t
+    tryPopBatch(OutputIter out, std::size_t maxCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Waits for an element, then pops it
+    ///
+    ////////////////////////////////////////////////////////////
+    T
+    pop()
+        requires isBlocking;
+
+    ////////////////////////////////////////////////////////////
+    // Any thread, approximate while the ring is in use
+    ////////////////////////////////////////////////////////////
+
+    std::size_t
+    size() const;
+
+    bool
+    empty() const
+    {
+        return size() == 0;
+    }
+
+    std::size_t
+    capacity() const
+    {
+        return mask + 1;
+    }
+
+private:
+
+    T *
+    slot(sp::Uint64 index) const
+    {
+        return slots + (index & mask);
+    }
+
+    // Free slots seen by the producer, refreshes cachedHead if needed
+    std::size_t
+    freeSlots(std::size_t wanted);
+
+    // Elements seen by the consumer, refreshes cachedTail if needed
+    std::size_t
+    availableElements(std::size_t wanted);
+
+    void
+    publishTail(sp::Uint64 newTail);
+
+    void
+    publishHead(sp::Uint64 newHead);
+
+    T * const slots;
+    const sp::Uint64 mask;
+
+    // Producer line
+    alignas(64) std::atomic<sp::Uint64> tail{0};
+    sp::Uint64 cachedHead = 0;
+
+    // Consumer line
+    alignas(64) std::atomic<sp::Uint64> head{0};
+    sp::Uint64 cachedTail = 0;
+
+    // Rarely written, read by both sides when blocking
+    alignas(64) std::atomic<bool> producerWaiting{false};
+    std::atomic<bool> consumerWaiting{false};
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Concurrency
+/// \brief Lock-free bounded queue for many producers and one consumer
+///
+/// Each slot carries a sequence number: producers claim a position with
+/// a compare exchange on the tail, then publish their slot by bumping
+/// its sequence. The consumer reads slots in order and never contends
+/// with producers for an index.
+///
+/// A producer that is preempted between claiming and publishing holds
+/// back the consumer (not the other producers) until it resumes.
+///
+/// \see SpscRing for isBlocking
+///
+////////////////////////////////////////////////////////////
+template <class T, bool isBlocking = false>
+class MpscRing
+{
+public:
+
+    typedef T value_type;
+
+    explicit MpscRing(std::size_t minCapacity);
+
+    MpscRing(const MpscRing &) = delete;
+
+    MpscRing &
+    operator=(const MpscRing &) = delete;
+
+    ~MpscRing();
+
+    ////////////////////////////////////////////////////////////
+    // Producers
+    ////////////////////////////////////////////////////////////
+
+    template <class... Args>
+    bool
+    tryEmplace(Args &&... args);
+
+    bool
+    tryPush(const T & value)
+    {
+        return tryEmplace(value);
+    }
+
+    bool
+    tryPush(T && value)
+    {
+        return tryEmplace(std::move(value));
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Claims room for as much of [start, finish) as fits at once
+    ///
+    /// The elements are contiguous in the ring, producers do not
+    /// interleave with them.
+    ///
+    /// \return an iterator to the first element that was not pushed
+    ///
+    ////////////////////////////////////////////////////////////
+    template <std::forward_iterator Iter>
+    Iter
+    tryPushBatch(Iter start, Iter finish);
+
+    template <class U>
+    void
+    push(U && value)
+        requires isBlocking;
+
+    ////////////////////////////////////////////////////////////
+    // Consumer
+    ////////////////////////////////////////////////////////////
+
+    bool
+    tryPop(T & out);
+
+    template <class OutputIter>
+    std::size_t
+    tryPopBatch(OutputIter out, std::size_t maxCount);
+
+    T
+    pop()
+        requires isBlocking;
+
+    ////////////////////////////////////////////////////////////
+    // Any thread, approximate while the ring is in use
+    ////////////////////////////////////////////////////////////
+
+    std::size_t
+    size() const;
+
+    bool
+    empty() const
+    {
+        return size() == 0;
+    }
+
+    std::size_t
+    capacity() const
+    {
+        return mask + 1;
+    }
+
+private:
+
+    struct Slot
+    {
+        // position + 1 once published, position + capacity once consumed
+        std::atomic<sp::Uint64> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+
+        T *
+        value()
+        {
+            return std::launder(reinterpret_cast<T *>(storage));
+        }
+    };
+
+    Slot &
+    slot(sp::Uint64 position) const
+    {
+        return slots[position & mask];
+    }
+
+    // Moves the element at position out if published
+    bool
+    take(sp::Uint64 position, T & out);
+
+    void
+    publish(Slot & slot, sp::Uint64 position);
+
+    void
+    publishHead(sp::Uint64 newHead);
+
+    Slot * const slots;
+    const sp::Uint64 mask;
+
+    // Shared by the producers
+    alignas(64) std::atomic<sp::Uint64> tail{0};
+
+    // Written by the consumer
+    alignas(64) std::atomic<sp::Uint64> head{0};
+
+    // Rarely written, read by all sides when blocking
+    alignas(64) std::atomic<sp::Uint32> waitingProducers{0};
+    std::atomic<bool> consumerWaiting{false};
+};
+
+} // namespace sp
+
+#include "Ring_inl.hpp"
+
+#endif // SPIRIT_RING_HPP
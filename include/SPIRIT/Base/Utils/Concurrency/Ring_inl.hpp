@@ -0,0 +1,508 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_RING_INL_HPP
+#define SPIRIT_RING_INL_HPP
+
+#include "Ring.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace sp
+{
+
+namespace details
+{
+
+inline std::size_t
+ringCapacity(std::size_t minCapacity)
+{
+    return std::bit_ceil(std::max<std::size_t>(minCapacity, 1));
+}
+
+// Slots start on their own cache line
+template <class Slot>
+Slot *
+allocateRing(std::size_t capacity)
+{
+    return static_cast<Slot *>(::operator new(
+        capacity * sizeof(Slot),
+        std::align_val_t{std::max<std::size_t>(alignof(Slot), 64)}
+    ));
+}
+
+template <class Slot>
+void
+deallocateRing(Slot * slots)
+{
+    ::operator delete(slots, std::align_val_t{std::max<std::size_t>(alignof(Slot), 64)});
+}
+
+} // namespace details
+
+
+////////////////////////////////////////////////////////////
+// SpscRing
+////////////////////////////////////////////////////////////
+
+template <class T, bool isBlocking>
+SpscRing<T, isBlocking>::SpscRing(std::size_t minCapacity)
+    : slots{details::allocateRing<T>(details::ringCapacity(minCapacity))},
+      mask{details::ringCapacity(minCapacity) - 1}
+{
+}
+
+template <class T, bool isBlocking>
+SpscRing<T, isBlocking>::~SpscRing()
+{
+    for (sp::Uint64 i = head.load(std::memory_order_relaxed),
+                    end = tail.load(std::memory_order_relaxed);
+         i != end;
+         ++i)
+        std::destroy_at(slot(i));
+
+    details::deallocateRing(slots);
+}
+
+template <class T, bool isBlocking>
+std::size_t
+SpscRing<T, isBlocking>::freeSlots(std::size_t wanted)
+{
+    sp::Uint64 current = tail.load(std::memory_order_relaxed);
+    std::size_t nFree  = capacity() - (current - cachedHead);
+    if (nFree < wanted)
+    {
+        cachedHead = head.load(std::memory_order_acquire);
+        nFree      = capacity() - (current - cachedHead);
+    }
+
+    return nFree;
+}
+
+template <class T, bool isBlocking>
+std::size_t
+SpscRing<T, isBlocking>::availableElements(std::size_t wanted)
+{
+    sp::Uint64 current    = head.load(std::memory_order_relaxed);
+    std::size_t available = cachedTail - current;
+    if (available < wanted)
+    {
+        cachedTail = tail.load(std::memory_order_acquire);
+        available  = cachedTail - current;
+    }
+
+    return available;
+}
+
+template <class T, bool isBlocking>
+void
+SpscRing<T, isBlocking>::publishTail(sp::Uint64 newTail)
+{
+    tail.store(newTail, std::memory_order_release);
+    if constexpr (isBlocking)
+    {
+        // Pairs with the consumer's flag store, one of us sees the other
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumerWaiting.load(std::memory_order_relaxed))
+            tail.notify_one();
+    }
+}
+
+template <class T, bool isBlocking>
+void
+SpscRing<T, isBlocking>::publishHead(sp::Uint64 newHead)
+{
+    head.store(newHead, std::memory_order_release);
+    if constexpr (isBlocking)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (producerWaiting.load(std::memory_order_relaxed))
+            head.notify_one();
+    }
+}
+
+template <class T, bool isBlocking>
+template <class... Args>
+bool
+SpscRing<T, isBlocking>::tryEmplace(Args &&... args)
+{
+    if (freeSlots(1) == 0)
+        return false;
+
+    sp::Uint64 current = tail.load(std::memory_order_relaxed);
+    ::new (static_cast<void *>(slot(current))) T(std::forward<Args>(args)...);
+    publishTail(current + 1);
+    return true;
+}
+
+template <class T, bool isBlocking>
+template <std::forward_iterator Iter>
+Iter
+SpscRing<T, isBlocking>::tryPushBatch(Iter start, Iter finish)
+{
+    auto wanted        = static_cast<std::size_t>(std::distance(start, finish));
+    std::size_t n      = std::min(wanted, freeSlots(wanted));
+    sp::Uint64 current = tail.load(std::memory_order_relaxed);
+
+    std::size_t i = 0;
+    try
+    {
+        for (; i < n; ++i, ++start)
+            ::new (static_cast<void *>(slot(current + i))) T(*start);
+    }
+    catch (...)
+    {
+        if (i != 0)
+            publishTail(current + i);
+        throw;
+    }
+
+    if (n != 0)
+        publishTail(current + n);
+    return start;
+}
+
+template <class T, bool isBlocking>
+template <class U>
+void
+SpscRing<T, isBlocking>::push(U && value)
+    requires isBlocking
+{
+    while (freeSlots(1) == 0)
+    {
+        producerWaiting.store(true, std::memory_order_seq_cst);
+        sp::Uint64 seen = head.load(std::memory_order_seq_cst);
+        if (tail.load(std::memory_order_relaxed) - seen == capacity())
+            head.wait(seen, std::memory_order_seq_cst);
+        producerWaiting.store(false, std::memory_order_relaxed);
+    }
+
+    tryEmplace(std::forward<U>(value));
+}
+
+template <class T, bool isBlocking>
+bool
+SpscRing<T, isBlocking>::tryPop(T & out)
+{
+    if (availableElements(1) == 0)
+        return false;
+
+    sp::Uint64 current = head.load(std::memory_order_relaxed);
+    out                = std::move(*slot(current));
+    std::destroy_at(slot(current));
+    publishHead(current + 1);
+    return true;
+}
+
+template <class T, bool isBlocking>
+template <class OutputIter>
+std::size_t
+SpscRing<T, isBlocking>::tryPopBatch(OutputIter out, std::size_t maxCount)
+{
+    std::size_t n      = std::min(maxCount, availableElements(maxCount));
+    sp::Uint64 current = head.load(std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < n; ++i, ++out)
+    {
+        *out = std::move(*slot(current + i));
+        std::destroy_at(slot(current + i));
+    }
+
+    if (n != 0)
+        publishHead(current + n);
+    return n;
+}
+
+template <class T, bool isBlocking>
+T
+SpscRing<T, isBlocking>::pop()
+    requires isBlocking
+{
+    while (availableElements(1) == 0)
+    {
+        consumerWaiting.store(true, std::memory_order_seq_cst);
+        sp::Uint64 seen = tail.load(std::memory_order_seq_cst);
+        if (seen == head.load(std::memory_order_relaxed))
+            tail.wait(seen, std::memory_order_seq_cst);
+        consumerWaiting.store(false, std::memory_order_relaxed);
+    }
+
+    sp::Uint64 current = head.load(std::memory_order_relaxed);
+    T value{std::move(*slot(current))};
+    std::destroy_at(slot(current));
+    publishHead(current + 1);
+    return value;
+}
+
+template <class T, bool isBlocking>
+std::size_t
+SpscRing<T, isBlocking>::size() const
+{
+    // head first, the tail can only be further
+    sp::Uint64 first = head.load(std::memory_order_acquire);
+    sp::Uint64 last  = tail.load(std::memory_order_acquire);
+    return static_cast<std::size_t>(last - first);
+}
+
+
+////////////////////////////////////////////////////////////
+// MpscRing
+////////////////////////////////////////////////////////////
+
+template <class T, bool isBlocking>
+MpscRing<T, isBlocking>::MpscRing(std::size_t minCapacity)
+    : slots{details::allocateRing<Slot>(details::ringCapacity(minCapacity))},
+      mask{details::ringCapacity(minCapacity) - 1}
+{
+    static_assert(
+        std::is_nothrow_move_constructible_v<T>,
+        "A claimed slot must be published, moves into it cannot throw"
+    );
+
+    for (sp::Uint64 i = 0; i < capacity(); ++i)
+    {
+        ::new (static_cast<void *>(slots + i)) Slot{};
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <class T, bool isBlocking>
+MpscRing<T, isBlocking>::~MpscRing()
+{
+    for (sp::Uint64 i = head.load(std::memory_order_relaxed);
+         slot(i).sequence.load(std::memory_order_acquire) == i + 1;
+         ++i)
+        std::destroy_at(slot(i).value());
+
+    std::destroy_n(slots, capacity());
+    details::deallocateRing(slots);
+}
+
+template <class T, bool isBlocking>
+void
+MpscRing<T, isBlocking>::publish(Slot & published, sp::Uint64 position)
+{
+    published.sequence.store(position + 1, std::memory_order_release);
+    if constexpr (isBlocking)
+    {
+        // Pairs with the consumer's flag store, one of us sees the other
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (consumerWaiting.load(std::memory_order_relaxed))
+            published.sequence.notify_one();
+    }
+}
+
+template <class T, bool isBlocking>
+void
+MpscRing<T, isBlocking>::publishHead(sp::Uint64 newHead)
+{
+    head.store(newHead, std::memory_order_release);
+    if constexpr (isBlocking)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waitingProducers.load(std::memory_order_relaxed) != 0)
+            head.notify_all();
+    }
+}
+
+template <class T, bool isBlocking>
+template <class... Args>
+bool
+MpscRing<T, isBlocking>::tryEmplace(Args &&... args)
+{
+    if constexpr (!std::is_nothrow_constructible_v<T, Args &&...>)
+    {
+        // Construct before claiming, a claimed slot cannot be given back
+        T value(std::forward<Args>(args)...);
+        return tryEmplace(std::move(value));
+    }
+    else
+    {
+        sp::Uint64 position = tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            sp::Uint64 sequence = slot(position).sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<sp::Int64>(sequence - position);
+
+            if (lag == 0)
+            {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (lag < 0)
+                return false; // the consumer has not reached this slot yet
+            else
+                position = tail.load(std::memory_order_relaxed);
+        }
+
+        Slot & claimed = slot(position);
+        ::new (static_cast<void *>(claimed.storage)) T(std::forward<Args>(args)...);
+        publish(claimed, position);
+        return true;
+    }
+}
+
+template <class T, bool isBlocking>
+template <std::forward_iterator Iter>
+Iter
+MpscRing<T, isBlocking>::tryPushBatch(Iter start, Iter finish)
+{
+    static_assert(
+        std::is_nothrow_constructible_v<T, std::iter_reference_t<Iter>>,
+        "Claimed slots must be published, use std::make_move_iterator"
+    );
+
+    auto wanted         = static_cast<std::size_t>(std::distance(start, finish));
+    sp::Uint64 position = tail.load(std::memory_order_relaxed);
+    std::size_t n       = 0;
+    do
+    {
+        // Slots before the consumer's head are free
+        sp::Uint64 first = head.load(std::memory_order_acquire);
+        n = std::min(wanted, capacity() - static_cast<std::size_t>(position - first));
+        if (n == 0)
+            return start;
+    } while (!tail.compare_exchange_weak(position, position + n, std::memory_order_relaxed));
+
+    for (std::size_t i = 0; i < n; ++i, ++start)
+    {
+        Slot & claimed = slot(position + i);
+        ::new (static_cast<void *>(claimed.storage)) T(*start);
+        publish(claimed, position + i);
+    }
+
+    return start;
+}
+
+template <class T, bool isBlocking>
+template <class U>
+void
+MpscRing<T, isBlocking>::push(U && value)
+    requires isBlocking
+{
+    // Converted once, retries move from it
+    T converted(std::forward<U>(value));
+    while (!tryEmplace(std::move(converted)))
+    {
+        waitingProducers.fetch_add(1, std::memory_order_seq_cst);
+        sp::Uint64 seen = head.load(std::memory_order_seq_cst);
+        if (tail.load(std::memory_order_relaxed) - seen >= capacity())
+            head.wait(seen, std::memory_order_seq_cst);
+        waitingProducers.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+template <class T, bool isBlocking>
+bool
+MpscRing<T, isBlocking>::take(sp::Uint64 position, T & out)
+{
+    Slot & taken = slot(position);
+    if (taken.sequence.load(std::memory_order_acquire) != position + 1)
+        return false;
+
+    out = std::move(*taken.value());
+    std::destroy_at(taken.value());
+
+    // Free for the producer of the next lap
+    taken.sequence.store(position + capacity(), std::memory_order_release);
+    return true;
+}
+
+template <class T, bool isBlocking>
+bool
+MpscRing<T, isBlocking>::tryPop(T & out)
+{
+    sp::Uint64 current = head.load(std::memory_order_relaxed);
+    if (!take(current, out))
+        return false;
+
+    publishHead(current + 1);
+    return true;
+}
+
+template <class T, bool isBlocking>
+template <class OutputIter>
+std::size_t
+MpscRing<T, isBlocking>::tryPopBatch(OutputIter out, std::size_t maxCount)
+{
+    sp::Uint64 current = head.load(std::memory_order_relaxed);
+
+    std::size_t n = 0;
+    for (; n < maxCount; ++n, ++out)
+    {
+        Slot & taken = slot(current + n);
+        if (taken.sequence.load(std::memory_order_acquire) != current + n + 1)
+            break;
+
+        *out = std::move(*taken.value());
+        std::destroy_at(taken.value());
+        taken.sequence.store(current + n + capacity(), std::memory_order_release);
+    }
+
+    if (n != 0)
+        publishHead(current + n);
+    return n;
+}
+
+template <class T, bool isBlocking>
+T
+MpscRing<T, isBlocking>::pop()
+    requires isBlocking
+{
+    sp::Uint64 current = head.load(std::memory_order_relaxed);
+    Slot & taken       = slot(current);
+
+    // Unpublished slots hold the position as their sequence
+    while (taken.sequence.load(std::memory_order_acquire) != current + 1)
+    {
+        consumerWaiting.store(true, std::memory_order_seq_cst);
+        taken.sequence.wait(current, std::memory_order_seq_cst);
+        consumerWaiting.store(false, std::memory_order_relaxed);
+    }
+
+    T value{std::move(*taken.value())};
+    std::destroy_at(taken.value());
+    taken.sequence.store(current + capacity(), std::memory_order_release);
+    publishHead(current + 1);
+    return value;
+}
+
+template <class T, bool isBlocking>
+std::size_t
+MpscRing<T, isBlocking>::size() const
+{
+    sp::Uint64 first = head.load(std::memory_order_acquire);
+    sp::Uint64 last  = tail.load(std::memory_order_acquire);
+    return static_cast<std::size_t>(std::min<sp::Uint64>(last - first, capacity()));
+}
+
+} // namespace sp
+
+
+#endif // SPIRIT_RING_INL_HPP
@@ -0,0 +1,385 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_BUCKET_HPP
+#define SPIRIT_BUCKET_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+/// \ingroup Base
+/// \defgroup Containers Containers
+///
+/// \brief Containers tuned for game loops (inline storage, stable slots...)
+///
+////////////////////////////////////////////////////////////
+
+namespace traits
+{
+
+////////////////////////////////////////////////////////////
+/// \ingroup Containers
+/// \brief Objects that may be moved in memory by copying their bytes
+///
+/// Relocating such an object with std::memmove is equivalent to move
+/// constructing it at the new address and destroying the original.
+/// Containers use this to shift elements without calling constructors.
+///
+/// True for trivially copyable types, specialize it for other types
+/// that do not point into themselves (ie std::unique_ptr).
+///
+////////////////////////////////////////////////////////////
+template <class T>
+struct isTriviallyRelocatable
+    : public std::bool_constant<std::is_trivially_copyable_v<T>>
+{
+};
+
+template <class T>
+inline constexpr bool isTriviallyRelocatable_v = isTriviallyRelocatable<T>::value;
+
+} // namespace traits
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Containers
+/// \brief Vector with a fixed capacity stored inline
+///
+/// Elements are contiguous and ordered, no allocation is ever made.
+/// Only the first size() slots hold live objects, the rest is raw storage.
+///
+/// Insertions into a full bucket are ignored: emplace_back() and
+/// push_back() return false, emplace() returns end() and ranged inserts
+/// report how much was inserted.
+///
+/// Elements are shifted with std::memmove when
+/// traits::isTriviallyRelocatable holds for ValueType,
+/// otherwise they are move constructed into place and the sources
+/// destroyed (const elements are supported, they are never assigned to).
+///
+////////////////////////////////////////////////////////////
+template <sp::Uint32 bucketSize, class ValueType>
+class Bucket
+{
+public:
+
+    typedef ValueType value_type;
+    typedef sp::Uint32 size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+    typedef value_type * pointer;
+    typedef const value_type * const_pointer;
+    typedef pointer iterator;
+    typedef const_pointer const_iterator;
+
+    static_assert(bucketSize > 0, "A bucket must hold at least one element");
+
+    Bucket() = default;
+
+    Bucket(const Bucket & other);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Takes other's elements, other is left empty
+    ///
+    ////////////////////////////////////////////////////////////
+    Bucket(Bucket && other) noexcept(
+        std::is_nothrow_move_constructible_v<value_type>
+    );
+
+    Bucket &
+    operator=(const Bucket & other);
+
+    Bucket &
+    operator=(Bucket && other) noexcept(
+        std::is_nothrow_move_constructible_v<value_type>
+    );
+
+    ~Bucket();
+
+    ////////////////////////////////////////////////////////////
+    // Capacity
+    ////////////////////////////////////////////////////////////
+
+    bool
+    empty() const
+    {
+        return last == 0;
+    }
+
+    size_type
+    size() const
+    {
+        return last;
+    }
+
+    size_type
+    count() const
+    {
+        return last;
+    }
+
+    static constexpr size_type
+    max_size()
+    {
+        return bucketSize;
+    }
+
+    static constexpr size_type
+    capacity()
+    {
+        return bucketSize;
+    }
+
+    bool
+    isFull() const
+    {
+        return last == bucketSize;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Element access
+    ////////////////////////////////////////////////////////////
+
+    reference
+    operator[](size_type pos)
+    {
+        return data()[pos];
+    }
+
+    const_reference
+    operator[](size_type pos) const
+    {
+        return data()[pos];
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Checked access, asserts that pos < size()
+    ///
+    ////////////////////////////////////////////////////////////
+    reference
+    at(size_type pos);
+
+    const_reference
+    at(size_type pos) const;
+
+    reference
+    front()
+    {
+        return data()[0];
+    }
+
+    const_reference
+    front() const
+    {
+        return data()[0];
+    }
+
+    reference
+    back()
+    {
+        return data()[last - 1];
+    }
+
+    const_reference
+    back() const
+    {
+        return data()[last - 1];
+    }
+
+    pointer
+    data()
+    {
+        return std::launder(reinterpret_cast<pointer>(storage));
+    }
+
+    const_pointer
+    data() const
+    {
+        return std::launder(reinterpret_cast<const_pointer>(storage));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Iterators
+    ////////////////////////////////////////////////////////////
+
+    iterator
+    begin()
+    {
+        return data();
+    }
+
+    const_iterator
+    begin() const
+    {
+        return data();
+    }
+
+    const_iterator
+    cbegin() const
+    {
+        return data();
+    }
+
+    iterator
+    end()
+    {
+        return data() + last;
+    }
+
+    const_iterator
+    end() const
+    {
+        return data() + last;
+    }
+
+    const_iterator
+    cend() const
+    {
+        return data() + last;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Modifiers
+    ////////////////////////////////////////////////////////////
+
+    void
+    clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructs an element at the end, false when full
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class... Args>
+    bool
+    emplace_back(Args &&... args);
+
+    bool
+    push_back(const value_type & value);
+
+    bool
+    push_back(value_type && value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Removes the last element, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    pop_back();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructs an element before pos
+    ///
+    /// \return an iterator to the new element or end() when full
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class... Args>
+    iterator
+    emplace(const_iterator pos, Args &&... args);
+
+    iterator
+    insert(const_iterator pos, const value_type & value);
+
+    iterator
+    insert(const_iterator pos, value_type && value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Inserts up to n copies of value before pos
+    ///
+    /// \return the number of copies inserted, limited by the free space
+    ///
+    ////////////////////////////////////////////////////////////
+    size_type
+    insert(const_iterator pos, size_type n, const value_type & value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Inserts as much of [start, finish) as fits before pos
+    ///
+    /// \return an iterator to the first element that was not inserted
+    ///
+    ////////////////////////////////////////////////////////////
+    template <std::forward_iterator Iter>
+    Iter
+    insert(const_iterator pos, Iter start, Iter finish);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Removes the element at pos
+    ///
+    /// \return an iterator to the element that followed the removed one
+    ///
+    ////////////////////////////////////////////////////////////
+    iterator
+    erase(const_iterator pos);
+
+    iterator
+    erase(const_iterator start, const_iterator finish);
+
+private:
+
+    template <class... Args>
+    static pointer
+    construct(pointer where, Args &&... args);
+
+    static void
+    destroy(pointer where);
+
+    static void
+    destroy(pointer start, pointer finish);
+
+    // Relocates [start, finish) count slots to the right/left.
+    // The destination slots must be raw storage, the sources become raw storage
+    static void
+    moveRight(pointer start, pointer finish, size_type count);
+
+    static void
+    moveLeft(pointer start, pointer finish, size_type count);
+
+    // Relocates all of other's elements into this empty bucket
+    void
+    takeFrom(Bucket & other);
+
+    iterator
+    mutableIterator(const_iterator it)
+    {
+        return data() + (it - cbegin());
+    }
+
+    alignas(value_type) std::byte storage[bucketSize * sizeof(value_type)];
+    size_type last = 0;
+};
+
+} // namespace sp
+
+#include "Bucket_inl.hpp"
+
+#endif // SPIRIT_BUCKET_HPP
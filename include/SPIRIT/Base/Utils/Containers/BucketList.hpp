@@ -0,0 +1,349 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_BUCKETLIST_HPP
+#define SPIRIT_BUCKETLIST_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "Bucket.hpp"
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+/// \ingroup Containers
+/// \brief Unordered container whose elements never move (a hive)
+///
+/// Elements live in chunks of chunkSize slots. Insertions fill a free
+/// slot of any chunk with room, or append a new chunk. Erasures only free
+/// their slot. Pointers, references and iterators to other elements stay
+/// valid through both.
+///
+/// Each chunk is cache line aligned and keeps a bitmask of its occupied
+/// slots, iteration skips runs of empty slots a word at a time.
+/// Erased slots go on the chunk's free list (a Bucket of slot indices)
+/// and are reused before fresh ones.
+///
+/// Emptied chunks are released, except for one that is kept in reserve
+/// so that a single insert/erase cycle does not allocate each time.
+///
+/// Iteration order is unspecified.
+///
+////////////////////////////////////////////////////////////
+template <class T, sp::Uint32 chunkSize = 64>
+class BucketList
+{
+    static_assert(chunkSize > 0, "Chunks must hold at least one element");
+
+    struct Chunk;
+
+    template <bool isConst>
+    class Iterator;
+
+public:
+
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+    typedef value_type * pointer;
+    typedef const value_type * const_pointer;
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    BucketList() = default;
+
+    BucketList(const BucketList & other);
+
+    BucketList(BucketList && other) noexcept;
+
+    BucketList &
+    operator=(const BucketList & other);
+
+    BucketList &
+    operator=(BucketList && other) noexcept;
+
+    ~BucketList();
+
+    ////////////////////////////////////////////////////////////
+    // Capacity
+    ////////////////////////////////////////////////////////////
+
+    bool
+    empty() const
+    {
+        return count == 0;
+    }
+
+    size_type
+    size() const
+    {
+        return count;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Number of slots in the allocated chunks, including the reserve
+    ///
+    ////////////////////////////////////////////////////////////
+    size_type
+    capacity() const
+    {
+        return (nChunks + (spare != nullptr)) * static_cast<size_type>(chunkSize);
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Releases the reserved chunk, if any
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    shrink_to_fit();
+
+    ////////////////////////////////////////////////////////////
+    // Iterators
+    ////////////////////////////////////////////////////////////
+
+    iterator
+    begin();
+
+    const_iterator
+    begin() const;
+
+    const_iterator
+    cbegin() const
+    {
+        return begin();
+    }
+
+    iterator
+    end()
+    {
+        return iterator{};
+    }
+
+    const_iterator
+    end() const
+    {
+        return const_iterator{};
+    }
+
+    const_iterator
+    cend() const
+    {
+        return const_iterator{};
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Iterator to the element at address elem
+    ///
+    /// Linear in the number of chunks, returns end() when elem
+    /// is not an element of this list.
+    ///
+    ////////////////////////////////////////////////////////////
+    iterator
+    getIterator(const_pointer elem);
+
+    const_iterator
+    getIterator(const_pointer elem) const;
+
+    ////////////////////////////////////////////////////////////
+    // Modifiers
+    ////////////////////////////////////////////////////////////
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructs an element in a free slot, O(1)
+    ///
+    /// \return an iterator to the new element
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class... Args>
+    iterator
+    emplace(Args &&... args);
+
+    iterator
+    insert(const value_type & value);
+
+    iterator
+    insert(value_type && value);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroys the element at pos, O(1)
+    ///
+    /// \return an iterator to the next element
+    ///
+    ////////////////////////////////////////////////////////////
+    iterator
+    erase(const_iterator pos);
+
+    void
+    clear();
+
+private:
+
+    // Slot indices, as small as possible to fit the free lists in cache
+    typedef std::conditional_t<(chunkSize <= 0xFFFF), sp::Uint16, sp::Uint32> SlotIndex;
+
+    static constexpr sp::Uint32 nWords = (chunkSize + 63) / 64;
+    static constexpr std::size_t chunkAlignment
+        = alignof(T) > 64 ? alignof(T) : 64;
+
+    struct alignas(chunkAlignment) Chunk
+    {
+        alignas(T) std::byte storage[chunkSize * sizeof(T)];
+
+        std::array<sp::Uint64, nWords> occupied{};
+
+        // Erased slots, reused before the ones past highWater
+        Bucket<chunkSize, SlotIndex> freed{};
+        sp::Uint32 highWater = 0;
+        sp::Uint32 count     = 0;
+
+        // All chunks, in allocation order
+        Chunk * prev = nullptr;
+        Chunk * next = nullptr;
+
+        // Chunks with free slots
+        Chunk * prevAvailable = nullptr;
+        Chunk * nextAvailable = nullptr;
+
+        pointer
+        slot(sp::Uint32 index)
+        {
+            return std::launder(reinterpret_cast<pointer>(storage)) + index;
+        }
+
+        bool
+        isOccupied(sp::Uint32 index) const
+        {
+            return (occupied[index / 64] >> (index % 64)) & 1;
+        }
+
+        // First occupied slot at or after index, chunkSize if none
+        sp::Uint32
+        nextOccupied(sp::Uint32 index) const;
+
+        bool
+        contains(const_pointer elem) const
+        {
+            auto first = reinterpret_cast<const_pointer>(storage);
+            return first <= elem && elem < first + chunkSize;
+        }
+    };
+
+    template <bool isConst>
+    class Iterator
+    {
+    public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef BucketList::value_type value_type;
+        typedef BucketList::difference_type difference_type;
+        typedef std::conditional_t<isConst, const_pointer, BucketList::pointer> pointer;
+        typedef std::conditional_t<isConst, const_reference, BucketList::reference> reference;
+
+        Iterator() = default;
+
+        // iterator converts to const_iterator
+        template <bool otherConst>
+            requires(isConst && !otherConst)
+        Iterator(const Iterator<otherConst> & other)
+            : chunk{other.chunk}, index{other.index}
+        {
+        }
+
+        reference
+        operator*() const
+        {
+            return *chunk->slot(index);
+        }
+
+        pointer
+        operator->() const
+        {
+            return chunk->slot(index);
+        }
+
+        Iterator &
+        operator++();
+
+        Iterator
+        operator++(int)
+        {
+            Iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        friend bool
+        operator==(const Iterator & lhs, const Iterator & rhs)
+        {
+            return lhs.chunk == rhs.chunk && lhs.index == rhs.index;
+        }
+
+    private:
+
+        friend class BucketList;
+
+        Iterator(Chunk * chunk, sp::Uint32 index) : chunk{chunk}, index{index} {}
+
+        // First element at or after (chunk, index)
+        static Iterator
+        seek(Chunk * chunk, sp::Uint32 index);
+
+        Chunk * chunk    = nullptr; // nullptr at end
+        sp::Uint32 index = 0;
+    };
+
+    Chunk *
+    acquireChunk();
+
+    void
+    releaseChunk(Chunk * chunk);
+
+    void
+    linkAvailable(Chunk * chunk);
+
+    void
+    unlinkAvailable(Chunk * chunk);
+
+    Chunk * head      = nullptr;
+    Chunk * tail      = nullptr;
+    Chunk * available = nullptr;
+    Chunk * spare     = nullptr;
+
+    size_type nChunks = 0;
+    size_type count   = 0;
+};
+
+} // namespace sp
+
+#include "BucketList_inl.hpp"
+
+#endif // SPIRIT_BUCKETLIST_HPP
@@ -0,0 +1,352 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_BUCKETLIST_INL_HPP
+#define SPIRIT_BUCKETLIST_INL_HPP
+
+#include "BucketList.hpp"
+
+#include <bit>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+// Special members
+////////////////////////////////////////////////////////////
+
+template <class T, sp::Uint32 chunkSize>
+BucketList<T, chunkSize>::BucketList(const BucketList & other)
+{
+    this->operator=(other);
+}
+
+template <class T, sp::Uint32 chunkSize>
+BucketList<T, chunkSize>::BucketList(BucketList && other) noexcept
+{
+    this->operator=(std::move(other));
+}
+
+template <class T, sp::Uint32 chunkSize>
+BucketList<T, chunkSize> &
+BucketList<T, chunkSize>::operator=(const BucketList & other)
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+    for (const_reference value : other)
+        emplace(value);
+
+    return *this;
+}
+
+template <class T, sp::Uint32 chunkSize>
+BucketList<T, chunkSize> &
+BucketList<T, chunkSize>::operator=(BucketList && other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+    shrink_to_fit();
+
+    head      = std::exchange(other.head, nullptr);
+    tail      = std::exchange(other.tail, nullptr);
+    available = std::exchange(other.available, nullptr);
+    spare     = std::exchange(other.spare, nullptr);
+    nChunks   = std::exchange(other.nChunks, 0);
+    count     = std::exchange(other.count, 0);
+    return *this;
+}
+
+template <class T, sp::Uint32 chunkSize>
+BucketList<T, chunkSize>::~BucketList()
+{
+    clear();
+    shrink_to_fit();
+}
+
+template <class T, sp::Uint32 chunkSize>
+void
+BucketList<T, chunkSize>::shrink_to_fit()
+{
+    delete std::exchange(spare, nullptr);
+}
+
+
+////////////////////////////////////////////////////////////
+// Iterators
+////////////////////////////////////////////////////////////
+
+template <class T, sp::Uint32 chunkSize>
+sp::Uint32
+BucketList<T, chunkSize>::Chunk::nextOccupied(sp::Uint32 index) const
+{
+    sp::Uint32 word = index / 64;
+    if (word >= nWords)
+        return chunkSize;
+
+    // Drop the bits below index, then skip whole empty words
+    sp::Uint64 bits = occupied[word] & (~sp::Uint64{0} << (index % 64));
+    while (bits == 0)
+    {
+        if (++word == nWords)
+            return chunkSize;
+        bits = occupied[word];
+    }
+
+    return word * 64 + static_cast<sp::Uint32>(std::countr_zero(bits));
+}
+
+template <class T, sp::Uint32 chunkSize>
+template <bool isConst>
+typename BucketList<T, chunkSize>::template Iterator<isConst>
+BucketList<T, chunkSize>::Iterator<isConst>::seek(Chunk * chunk, sp::Uint32 index)
+{
+    // Chunks are never empty, except for the reserve which is not linked
+    for (; chunk != nullptr; chunk = chunk->next, index = 0)
+    {
+        sp::Uint32 found = chunk->nextOccupied(index);
+        if (found < chunkSize)
+            return Iterator{chunk, found};
+    }
+
+    return Iterator{};
+}
+
+template <class T, sp::Uint32 chunkSize>
+template <bool isConst>
+typename BucketList<T, chunkSize>::template Iterator<isConst> &
+BucketList<T, chunkSize>::Iterator<isConst>::operator++()
+{
+    *this = seek(chunk, index + 1);
+    return *this;
+}
+
+template <class T, sp::Uint32 chunkSize>
+typename BucketList<T, chunkSize>::iterator
+BucketList<T, chunkSize>::begin()
+{
+    return iterator::seek(head, 0);
+}
+
+template <class T, sp::Uint32 chunkSize>
+typename BucketList<T, chunkSize>::const_iterator
+BucketList<T, chunkSize>::begin() const
+{
+    return const_iterator::seek(head, 0);
+}
+
+template <class T, sp::Uint32 chunkSize>
+typename BucketList<T, chunkSize>::iterator
+BucketList<T, chunkSize>::getIterator(const_pointer elem)
+{
+    for (Chunk * chunk = head; chunk != nullptr; chunk = chunk->next)
+    {
+        if (!chunk->contains(elem))
+            continue;
+
+        auto index = static_cast<sp::Uint32>(elem - chunk->slot(0));
+        return chunk->isOccupied(index) ? iterator{chunk, index} : end();
+    }
+
+    return end();
+}
+
+template <class T, sp::Uint32 chunkSize>
+typename BucketList<T, chunkSize>::const_iterator
+BucketList<T, chunkSize>::getIterator(const_pointer elem) const
+{
+    return const_cast<BucketList *>(this)->getIterator(elem);
+}
+
+
+////////////////////////////////////////////////////////////
+// Modifiers
+////////////////////////////////////////////////////////////
+
+template <class T, sp::Uint32 chunkSize>
+template <class... Args>
+typename BucketList<T, chunkSize>::iterator
+BucketList<T, chunkSize>::emplace(Args &&... args)
+{
+    Chunk * chunk = available != nullptr ? available : acquireChunk();
+
+    sp::Uint32 index = chunk->freed.empty() ? chunk->highWater
+                                            : chunk->freed.back();
+
+    // Nothing is committed until the element is constructed
+    ::new (static_cast<void *>(chunk->slot(index))) T(std::forward<Args>(args)...);
+
+    if (chunk->freed.empty())
+        ++chunk->highWater;
+    else
+        chunk->freed.pop_back();
+
+    chunk->occupied[index / 64] |= sp::Uint64{1} << (index % 64);
+    ++count;
+    if (++chunk->count == chunkSize)
+        unlinkAvailable(chunk);
+
+    return iterator{chunk, index};
+}
+
+template <class T, sp::Uint32 chunkSize>
+typename BucketList<T, chunkSize>::iterator
+BucketList<T, chunkSize>::insert(const value_type & value)
+{
+    return emplace(value);
+}
+
+template <class T, sp::Uint32 chunkSize>
+typename BucketList<T, chunkSize>::iterator
+BucketList<T, chunkSize>::insert(value_type && value)
+{
+    return emplace(std::move(value));
+}
+
+template <class T, sp::Uint32 chunkSize>
+typename BucketList<T, chunkSize>::iterator
+BucketList<T, chunkSize>::erase(const_iterator pos)
+{
+    Chunk * chunk    = pos.chunk;
+    sp::Uint32 index = pos.index;
+    iterator next    = iterator::seek(chunk, index + 1);
+
+    std::destroy_at(chunk->slot(index));
+    chunk->occupied[index / 64] &= ~(sp::Uint64{1} << (index % 64));
+    chunk->freed.push_back(static_cast<SlotIndex>(index));
+    --count;
+
+    if (chunk->count-- == chunkSize)
+        linkAvailable(chunk);
+
+    if (chunk->count == 0)
+        releaseChunk(chunk);
+
+    return next;
+}
+
+template <class T, sp::Uint32 chunkSize>
+void
+BucketList<T, chunkSize>::clear()
+{
+    while (head != nullptr)
+    {
+        Chunk * chunk = head;
+        if constexpr (!std::is_trivially_destructible_v<T>)
+        {
+            for (sp::Uint32 index = chunk->nextOccupied(0); index < chunkSize;
+                 index            = chunk->nextOccupied(index + 1))
+                std::destroy_at(chunk->slot(index));
+        }
+
+        releaseChunk(chunk);
+    }
+
+    count = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+// Chunks
+////////////////////////////////////////////////////////////
+
+template <class T, sp::Uint32 chunkSize>
+typename BucketList<T, chunkSize>::Chunk *
+BucketList<T, chunkSize>::acquireChunk()
+{
+    Chunk * chunk = spare != nullptr ? std::exchange(spare, nullptr) : new Chunk;
+
+    chunk->prev = tail;
+    chunk->next = nullptr;
+    (tail != nullptr ? tail->next : head) = chunk;
+    tail = chunk;
+    ++nChunks;
+
+    linkAvailable(chunk);
+    return chunk;
+}
+
+// The chunk's elements must have been destroyed
+template <class T, sp::Uint32 chunkSize>
+void
+BucketList<T, chunkSize>::releaseChunk(Chunk * chunk)
+{
+    // Only full chunks are missing from the available list
+    if (chunk->count != chunkSize)
+        unlinkAvailable(chunk);
+
+    (chunk->prev != nullptr ? chunk->prev->next : head) = chunk->next;
+    (chunk->next != nullptr ? chunk->next->prev : tail) = chunk->prev;
+    --nChunks;
+
+    if (spare != nullptr)
+    {
+        delete chunk;
+        return;
+    }
+
+    chunk->occupied  = {};
+    chunk->freed.clear();
+    chunk->highWater = 0;
+    chunk->count     = 0;
+    spare            = chunk;
+}
+
+template <class T, sp::Uint32 chunkSize>
+void
+BucketList<T, chunkSize>::linkAvailable(Chunk * chunk)
+{
+    chunk->prevAvailable = nullptr;
+    chunk->nextAvailable = available;
+    if (available != nullptr)
+        available->prevAvailable = chunk;
+    available = chunk;
+}
+
+template <class T, sp::Uint32 chunkSize>
+void
+BucketList<T, chunkSize>::unlinkAvailable(Chunk * chunk)
+{
+    (chunk->prevAvailable != nullptr ? chunk->prevAvailable->nextAvailable
+                                     : available)
+        = chunk->nextAvailable;
+    if (chunk->nextAvailable != nullptr)
+        chunk->nextAvailable->prevAvailable = chunk->prevAvailable;
+
+    chunk->prevAvailable = nullptr;
+    chunk->nextAvailable = nullptr;
+}
+
+
+} // namespace sp
+
+
+#endif // SPIRIT_BUCKETLIST_INL_HPP
@@ -0,0 +1,403 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_BUCKET_INL_HPP
+#define SPIRIT_BUCKET_INL_HPP
+
+#include "Bucket.hpp"
+#include "SPIRIT/Base/Error/Error.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+// Special members
+////////////////////////////////////////////////////////////
+
+template <sp::Uint32 bucketSize, class ValueType>
+Bucket<bucketSize, ValueType>::Bucket(const Bucket & other)
+{
+    this->operator=(other);
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+Bucket<bucketSize, ValueType>::Bucket(Bucket && other) noexcept(
+    std::is_nothrow_move_constructible_v<value_type>
+)
+{
+    takeFrom(other);
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+Bucket<bucketSize, ValueType> &
+Bucket<bucketSize, ValueType>::operator=(const Bucket & other)
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+    if constexpr (std::is_trivially_copyable_v<value_type>)
+    {
+        // Only the live elements, the rest of the storage is uninitialized
+        std::memcpy(storage, other.storage, other.last * sizeof(value_type));
+        last = other.last;
+    }
+    else
+    {
+        for (const_reference value : other)
+        {
+            construct(end(), value);
+            ++last;
+        }
+    }
+
+    return *this;
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+Bucket<bucketSize, ValueType> &
+Bucket<bucketSize, ValueType>::operator=(Bucket && other) noexcept(
+    std::is_nothrow_move_constructible_v<value_type>
+)
+{
+    if (this != &other)
+    {
+        clear();
+        takeFrom(other);
+    }
+
+    return *this;
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+Bucket<bucketSize, ValueType>::~Bucket()
+{
+    clear();
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+void
+Bucket<bucketSize, ValueType>::takeFrom(Bucket & other)
+{
+    if constexpr (traits::isTriviallyRelocatable_v<value_type>)
+    {
+        std::memcpy(storage, other.storage, other.last * sizeof(value_type));
+        last = other.last;
+    }
+    else
+    {
+        for (reference value : other)
+        {
+            construct(end(), std::move(value));
+            ++last;
+        }
+
+        destroy(other.begin(), other.end());
+    }
+
+    other.last = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+// Element access
+////////////////////////////////////////////////////////////
+
+template <sp::Uint32 bucketSize, class ValueType>
+typename Bucket<bucketSize, ValueType>::reference
+Bucket<bucketSize, ValueType>::at(size_type pos)
+{
+    SPIRIT_ASSERT(
+        pos < count(),
+        "element at {} is out of range, bucket size is {}",
+        pos,
+        count()
+    );
+    return data()[pos];
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+typename Bucket<bucketSize, ValueType>::const_reference
+Bucket<bucketSize, ValueType>::at(size_type pos) const
+{
+    SPIRIT_ASSERT(
+        pos < count(),
+        "element at {} is out of range, bucket size is {}",
+        pos,
+        count()
+    );
+    return data()[pos];
+}
+
+
+////////////////////////////////////////////////////////////
+// Modifiers
+////////////////////////////////////////////////////////////
+
+template <sp::Uint32 bucketSize, class ValueType>
+void
+Bucket<bucketSize, ValueType>::clear()
+{
+    destroy(begin(), end());
+    last = 0;
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+template <class... Args>
+bool
+Bucket<bucketSize, ValueType>::emplace_back(Args &&... args)
+{
+    if (isFull())
+        return false;
+
+    construct(end(), std::forward<Args>(args)...);
+    ++last;
+    return true;
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+bool
+Bucket<bucketSize, ValueType>::push_back(const value_type & value)
+{
+    return emplace_back(value);
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+bool
+Bucket<bucketSize, ValueType>::push_back(value_type && value)
+{
+    return emplace_back(std::move(value));
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+void
+Bucket<bucketSize, ValueType>::pop_back()
+{
+    if (empty())
+        return;
+
+    destroy(data() + --last);
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+template <class... Args>
+typename Bucket<bucketSize, ValueType>::iterator
+Bucket<bucketSize, ValueType>::emplace(const_iterator pos, Args &&... args)
+{
+    if (isFull())
+        return end();
+
+    iterator location = mutableIterator(pos);
+    if (location == end())
+    {
+        construct(location, std::forward<Args>(args)...);
+        ++last;
+        return location;
+    }
+
+    // Arguments may refer to an element that is about to be shifted
+    value_type value(std::forward<Args>(args)...);
+    moveRight(location, end(), 1);
+    construct(location, std::move(value));
+    ++last;
+    return location;
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+typename Bucket<bucketSize, ValueType>::iterator
+Bucket<bucketSize, ValueType>::insert(const_iterator pos, const value_type & value)
+{
+    return emplace(pos, value);
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+typename Bucket<bucketSize, ValueType>::iterator
+Bucket<bucketSize, ValueType>::insert(const_iterator pos, value_type && value)
+{
+    return emplace(pos, std::move(value));
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+typename Bucket<bucketSize, ValueType>::size_type
+Bucket<bucketSize, ValueType>::insert(
+    const_iterator pos,
+    size_type n,
+    const value_type & value
+)
+{
+    size_type nCopies = std::min(n, capacity() - size());
+    if (nCopies == 0)
+        return 0;
+
+    // value may refer to an element that is about to be shifted
+    value_type copy(value);
+
+    iterator location = mutableIterator(pos);
+    moveRight(location, end(), nCopies);
+    for (size_type i = 0; i < nCopies; ++i)
+        construct(location + i, copy);
+
+    last += nCopies;
+    return nCopies;
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+template <std::forward_iterator Iter>
+Iter
+Bucket<bucketSize, ValueType>::insert(const_iterator pos, Iter start, Iter finish)
+{
+    size_type n       = static_cast<size_type>(std::distance(start, finish));
+    size_type nCopies = std::min(n, capacity() - size());
+
+    iterator location = mutableIterator(pos);
+    moveRight(location, end(), nCopies);
+    for (size_type i = 0; i < nCopies; ++i, ++start)
+        construct(location + i, *start);
+
+    last += nCopies;
+    return start;
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+typename Bucket<bucketSize, ValueType>::iterator
+Bucket<bucketSize, ValueType>::erase(const_iterator pos)
+{
+    return erase(pos, pos + 1);
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+typename Bucket<bucketSize, ValueType>::iterator
+Bucket<bucketSize, ValueType>::erase(const_iterator start, const_iterator finish)
+{
+    iterator first = mutableIterator(start);
+    iterator after = mutableIterator(finish);
+    if (first == after)
+        return first;
+
+    size_type n = static_cast<size_type>(after - first);
+    destroy(first, after);
+    moveLeft(after, end(), n);
+
+    last -= n;
+    return first;
+}
+
+
+////////////////////////////////////////////////////////////
+// Raw storage helpers
+////////////////////////////////////////////////////////////
+
+template <sp::Uint32 bucketSize, class ValueType>
+template <class... Args>
+typename Bucket<bucketSize, ValueType>::pointer
+Bucket<bucketSize, ValueType>::construct(pointer where, Args &&... args)
+{
+    // value_type may be const, the storage itself never is
+    void * raw = const_cast<std::remove_const_t<value_type> *>(where);
+    return ::new (raw) value_type(std::forward<Args>(args)...);
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+void
+Bucket<bucketSize, ValueType>::destroy(pointer where)
+{
+    where->~value_type();
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+void
+Bucket<bucketSize, ValueType>::destroy(pointer start, pointer finish)
+{
+    if constexpr (!std::is_trivially_destructible_v<value_type>)
+    {
+        for (; start != finish; ++start)
+            destroy(start);
+    }
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+void
+Bucket<bucketSize, ValueType>::moveRight(pointer start, pointer finish, size_type count)
+{
+    SPIRIT_ASSERT_FULL(start <= finish, "Invalid range");
+    if (count == 0 || start == finish)
+        return;
+
+    if constexpr (traits::isTriviallyRelocatable_v<value_type>)
+    {
+        std::memmove(
+            static_cast<void *>(const_cast<std::remove_const_t<value_type> *>(start + count)),
+            start,
+            (finish - start) * sizeof(value_type)
+        );
+    }
+    else
+    {
+        // Back to front, the destination may overlap the sources
+        while (finish != start)
+        {
+            --finish;
+            construct(finish + count, std::move(*finish));
+            destroy(finish);
+        }
+    }
+}
+
+template <sp::Uint32 bucketSize, class ValueType>
+void
+Bucket<bucketSize, ValueType>::moveLeft(pointer start, pointer finish, size_type count)
+{
+    SPIRIT_ASSERT_FULL(start <= finish, "Invalid range");
+    if (count == 0 || start == finish)
+        return;
+
+    if constexpr (traits::isTriviallyRelocatable_v<value_type>)
+    {
+        std::memmove(
+            static_cast<void *>(const_cast<std::remove_const_t<value_type> *>(start - count)),
+            start,
+            (finish - start) * sizeof(value_type)
+        );
+    }
+    else
+    {
+        // Front to back, the destination may overlap the sources
+        for (; start != finish; ++start)
+        {
+            construct(start - count, std::move(*start));
+            destroy(start);
+        }
+    }
+}
+
+
+} // namespace sp
+
+
+#endif // SPIRIT_BUCKET_INL_HPP
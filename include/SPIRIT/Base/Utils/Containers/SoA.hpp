@@ -0,0 +1,473 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_SOA_HPP
+#define SPIRIT_SOA_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "Bucket.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <utility>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+/// \ingroup Containers
+/// \brief Vector of tuples stored as one array per field
+///
+/// Loops over one or two fields of many rows only load those fields,
+/// and column() exposes each field as a contiguous span aligned to
+/// a cache line, which compilers can vectorize:
+/// \code
+/// sp::SoA<Vec3, Vec3, Mass> bodies{};
+/// bodies.emplace_back(position, velocity, mass);
+///
+/// auto positions  = bodies.column<0>();
+/// auto velocities = bodies.column<1>();
+/// for (std::size_t i = 0; i < positions.size(); ++i)
+///     positions[i] += velocities[i] * dt;
+///
+/// for (auto [position, velocity, mass] : bodies) // references
+///     ...
+/// \endcode
+///
+/// Rows are accessed through proxies, std::tuple<Fields &...>.
+/// Algorithms that swap rows (ie std::sort) do not accept them,
+/// sort an index array instead.
+/// Like std::vector, growth and erasure invalidate references.
+///
+////////////////////////////////////////////////////////////
+template <class... Fields>
+class SoA
+{
+    static_assert(sizeof...(Fields) > 0, "A SoA needs at least one field");
+
+    template <bool isConst>
+    class Iterator;
+
+public:
+
+    typedef std::tuple<Fields...> value_type;
+    typedef std::tuple<Fields &...> reference;
+    typedef std::tuple<const Fields &...> const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    template <std::size_t I>
+    using Field = std::tuple_element_t<I, value_type>;
+
+    static constexpr std::size_t nFields = sizeof...(Fields);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Alignment of each column, at least a cache line
+    ///
+    ////////////////////////////////////////////////////////////
+    static constexpr std::size_t columnAlignment
+        = std::max({std::size_t{64}, alignof(Fields)...});
+
+    SoA() = default;
+
+    SoA(const SoA & other);
+
+    SoA(SoA && other) noexcept;
+
+    SoA &
+    operator=(const SoA & other);
+
+    SoA &
+    operator=(SoA && other) noexcept;
+
+    ~SoA();
+
+    ////////////////////////////////////////////////////////////
+    // Capacity
+    ////////////////////////////////////////////////////////////
+
+    bool
+    empty() const
+    {
+        return count == 0;
+    }
+
+    size_type
+    size() const
+    {
+        return count;
+    }
+
+    size_type
+    capacity() const
+    {
+        return cap;
+    }
+
+    void
+    reserve(size_type newCapacity);
+
+    ////////////////////////////////////////////////////////////
+    // Element access
+    ////////////////////////////////////////////////////////////
+
+    reference
+    operator[](size_type index)
+    {
+        return row(index, std::index_sequence_for<Fields...>{});
+    }
+
+    const_reference
+    operator[](size_type index) const
+    {
+        return row(index, std::index_sequence_for<Fields...>{});
+    }
+
+    reference
+    front()
+    {
+        return (*this)[0];
+    }
+
+    const_reference
+    front() const
+    {
+        return (*this)[0];
+    }
+
+    reference
+    back()
+    {
+        return (*this)[count - 1];
+    }
+
+    const_reference
+    back() const
+    {
+        return (*this)[count - 1];
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Field I of the row at index
+    ///
+    ////////////////////////////////////////////////////////////
+    template <std::size_t I>
+    Field<I> &
+    get(size_type index)
+    {
+        return data<I>()[index];
+    }
+
+    template <std::size_t I>
+    const Field<I> &
+    get(size_type index) const
+    {
+        return data<I>()[index];
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief All values of field I, aligned to columnAlignment
+    ///
+    ////////////////////////////////////////////////////////////
+    template <std::size_t I>
+    std::span<Field<I>>
+    column()
+    {
+        return {data<I>(), count};
+    }
+
+    template <std::size_t I>
+    std::span<const Field<I>>
+    column() const
+    {
+        return {data<I>(), count};
+    }
+
+    template <std::size_t I>
+    Field<I> *
+    data()
+    {
+        return std::assume_aligned<columnAlignment>(std::get<I>(columns));
+    }
+
+    template <std::size_t I>
+    const Field<I> *
+    data() const
+    {
+        return std::assume_aligned<columnAlignment>(std::get<I>(columns));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Iterators
+    ////////////////////////////////////////////////////////////
+
+    iterator
+    begin()
+    {
+        return iterator{this, 0};
+    }
+
+    const_iterator
+    begin() const
+    {
+        return const_iterator{this, 0};
+    }
+
+    const_iterator
+    cbegin() const
+    {
+        return begin();
+    }
+
+    iterator
+    end()
+    {
+        return iterator{this, count};
+    }
+
+    const_iterator
+    end() const
+    {
+        return const_iterator{this, count};
+    }
+
+    const_iterator
+    cend() const
+    {
+        return end();
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Modifiers
+    ////////////////////////////////////////////////////////////
+
+    void
+    clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Appends a row, each field constructed from its argument
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class... Args>
+        requires(sizeof...(Args) == sizeof...(Fields))
+    reference
+    emplace_back(Args &&... args);
+
+    void
+    push_back(const value_type & value);
+
+    void
+    push_back(value_type && value);
+
+    void
+    pop_back();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Removes the row at pos, the following rows are shifted
+    ///
+    /// \return an iterator to the row that followed the removed one
+    ///
+    ////////////////////////////////////////////////////////////
+    iterator
+    erase(const_iterator pos);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Removes the row at index by moving the last row into it, O(1)
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    eraseUnordered(size_type index);
+
+private:
+
+    template <std::size_t... Is>
+    reference
+    row(size_type index, std::index_sequence<Is...>)
+    {
+        return reference{data<Is>()[index]...};
+    }
+
+    template <std::size_t... Is>
+    const_reference
+    row(size_type index, std::index_sequence<Is...>) const
+    {
+        return const_reference{data<Is>()[index]...};
+    }
+
+    // Destroys the rows at and after index
+    void
+    destroyFrom(size_type index);
+
+    void
+    release();
+
+    template <bool isConst>
+    class Iterator
+    {
+        typedef std::conditional_t<isConst, const SoA, SoA> Container;
+
+    public:
+
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef SoA::value_type value_type;
+        typedef SoA::difference_type difference_type;
+        typedef std::conditional_t<isConst, const_reference, SoA::reference> reference;
+        typedef void pointer;
+
+        Iterator() = default;
+
+        // iterator converts to const_iterator
+        template <bool otherConst>
+            requires(isConst && !otherConst)
+        Iterator(const Iterator<otherConst> & other)
+            : soa{other.soa}, index{other.index}
+        {
+        }
+
+        reference
+        operator*() const
+        {
+            return (*soa)[index];
+        }
+
+        reference
+        operator[](difference_type n) const
+        {
+            return (*soa)[index + n];
+        }
+
+        Iterator &
+        operator++()
+        {
+            ++index;
+            return *this;
+        }
+
+        Iterator
+        operator++(int)
+        {
+            return Iterator{soa, index++};
+        }
+
+        Iterator &
+        operator--()
+        {
+            --index;
+            return *this;
+        }
+
+        Iterator
+        operator--(int)
+        {
+            return Iterator{soa, index--};
+        }
+
+        Iterator &
+        operator+=(difference_type n)
+        {
+            index += n;
+            return *this;
+        }
+
+        Iterator &
+        operator-=(difference_type n)
+        {
+            index -= n;
+            return *this;
+        }
+
+        friend Iterator
+        operator+(Iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend Iterator
+        operator+(difference_type n, Iterator it)
+        {
+            return it += n;
+        }
+
+        friend Iterator
+        operator-(Iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type
+        operator-(const Iterator & lhs, const Iterator & rhs)
+        {
+            return static_cast<difference_type>(lhs.index)
+                   - static_cast<difference_type>(rhs.index);
+        }
+
+        friend bool
+        operator==(const Iterator & lhs, const Iterator & rhs)
+        {
+            return lhs.index == rhs.index;
+        }
+
+        friend std::strong_ordering
+        operator<=>(const Iterator & lhs, const Iterator & rhs)
+        {
+            return lhs.index <=> rhs.index;
+        }
+
+        size_type
+        getIndex() const
+        {
+            return index;
+        }
+
+    private:
+
+        friend class SoA;
+
+        Iterator(Container * soa, size_type index) : soa{soa}, index{index} {}
+
+        Container * soa = nullptr;
+        size_type index = 0;
+    };
+
+    // One allocation, columns are at aligned offsets in it
+    std::byte * storage = nullptr;
+    std::tuple<Fields *...> columns{};
+
+    size_type count = 0;
+    size_type cap   = 0;
+};
+
+} // namespace sp
+
+#include "SoA_inl.hpp"
+
+#endif // SPIRIT_SOA_HPP
@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_SOA_INL_HPP
+#define SPIRIT_SOA_INL_HPP
+
+#include "SoA.hpp"
+
+#include <array>
+#include <cstring>
+#include <new>
+
+namespace sp
+{
+
+namespace details
+{
+
+// Relocates count objects into raw storage, the sources become raw storage
+template <class T>
+void
+relocate(T * from, T * to, std::size_t count)
+{
+    if constexpr (traits::isTriviallyRelocatable_v<T>)
+    {
+        if (count != 0)
+            std::memcpy(static_cast<void *>(to), from, count * sizeof(T));
+    }
+    else
+    {
+        std::uninitialized_move_n(from, count, to);
+        std::destroy_n(from, count);
+    }
+}
+
+} // namespace details
+
+
+////////////////////////////////////////////////////////////
+// Special members
+////////////////////////////////////////////////////////////
+
+template <class... Fields>
+SoA<Fields...>::SoA(const SoA & other)
+{
+    this->operator=(other);
+}
+
+template <class... Fields>
+SoA<Fields...>::SoA(SoA && other) noexcept
+{
+    this->operator=(std::move(other));
+}
+
+template <class... Fields>
+SoA<Fields...> &
+SoA<Fields...>::operator=(const SoA & other)
+{
+    if (this == &other)
+        return *this;
+
+    clear();
+    reserve(other.count);
+    for (const_reference values : other)
+        std::apply([this](const Fields &... fields) { emplace_back(fields...); }, values);
+
+    return *this;
+}
+
+template <class... Fields>
+SoA<Fields...> &
+SoA<Fields...>::operator=(SoA && other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    release();
+    storage = std::exchange(other.storage, nullptr);
+    columns = std::exchange(other.columns, {});
+    count   = std::exchange(other.count, 0);
+    cap     = std::exchange(other.cap, 0);
+    return *this;
+}
+
+template <class... Fields>
+SoA<Fields...>::~SoA()
+{
+    release();
+}
+
+
+////////////////////////////////////////////////////////////
+// Capacity
+////////////////////////////////////////////////////////////
+
+template <class... Fields>
+void
+SoA<Fields...>::reserve(size_type newCapacity)
+{
+    if (newCapacity <= cap)
+        return;
+
+    auto roundUp = [](std::size_t size)
+    { return (size + columnAlignment - 1) / columnAlignment * columnAlignment; };
+
+    // Columns follow each other, each starting on an aligned offset
+    std::array<std::size_t, nFields> sizes{sizeof(Fields) * newCapacity...};
+    std::array<std::size_t, nFields> offsets{};
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < nFields; ++i)
+    {
+        offsets[i] = total;
+        total      = roundUp(total + sizes[i]);
+    }
+
+    auto * newStorage = static_cast<std::byte *>(
+        ::operator new(total, std::align_val_t{columnAlignment})
+    );
+
+    [&]<std::size_t... Is>(std::index_sequence<Is...>)
+    {
+        std::tuple<Fields *...> newColumns{
+            reinterpret_cast<Fields *>(newStorage + offsets[Is])...};
+
+        (details::relocate(std::get<Is>(columns), std::get<Is>(newColumns), count),
+         ...);
+        columns = newColumns;
+    }(std::index_sequence_for<Fields...>{});
+
+    if (storage != nullptr)
+        ::operator delete(storage, std::align_val_t{columnAlignment});
+
+    storage = newStorage;
+    cap     = newCapacity;
+}
+
+
+////////////////////////////////////////////////////////////
+// Modifiers
+////////////////////////////////////////////////////////////
+
+template <class... Fields>
+void
+SoA<Fields...>::clear()
+{
+    destroyFrom(0);
+    count = 0;
+}
+
+template <class... Fields>
+template <class... Args>
+    requires(sizeof...(Args) == sizeof...(Fields))
+typename SoA<Fields...>::reference
+SoA<Fields...>::emplace_back(Args &&... args)
+{
+    if (count == cap)
+    {
+        // The arguments may refer to our own rows, which are about to move
+        value_type values{std::forward<Args>(args)...};
+        reserve(std::max<size_type>(8, 2 * cap));
+        std::apply([this](Fields &... fields) { emplace_back(std::move(fields)...); }, values);
+        return back();
+    }
+
+    [&]<std::size_t... Is>(std::index_sequence<Is...>)
+    {
+        std::size_t constructed = 0;
+        try
+        {
+            ((::new (static_cast<void *>(data<Is>() + count))
+                  Field<Is>(std::forward<Args>(args)),
+              ++constructed),
+             ...);
+        }
+        catch (...)
+        {
+            ((Is < constructed ? std::destroy_at(data<Is>() + count) : void()), ...);
+            throw;
+        }
+    }(std::index_sequence_for<Fields...>{});
+
+    ++count;
+    return back();
+}
+
+template <class... Fields>
+void
+SoA<Fields...>::push_back(const value_type & value)
+{
+    std::apply([this](const Fields &... fields) { emplace_back(fields...); }, value);
+}
+
+template <class... Fields>
+void
+SoA<Fields...>::push_back(value_type && value)
+{
+    std::apply([this](Fields &... fields) { emplace_back(std::move(fields)...); }, value);
+}
+
+template <class... Fields>
+void
+SoA<Fields...>::pop_back()
+{
+    if (count == 0)
+        return;
+
+    destroyFrom(count - 1);
+    --count;
+}
+
+template <class... Fields>
+typename SoA<Fields...>::iterator
+SoA<Fields...>::erase(const_iterator pos)
+{
+    size_type index = pos.index;
+
+    [&]<std::size_t... Is>(std::index_sequence<Is...>)
+    {
+        (std::move(data<Is>() + index + 1, data<Is>() + count, data<Is>() + index), ...);
+    }(std::index_sequence_for<Fields...>{});
+
+    pop_back();
+    return iterator{this, index};
+}
+
+template <class... Fields>
+void
+SoA<Fields...>::eraseUnordered(size_type index)
+{
+    if (index + 1 != count)
+    {
+        [&]<std::size_t... Is>(std::index_sequence<Is...>)
+        {
+            ((data<Is>()[index] = std::move(data<Is>()[count - 1])), ...);
+        }(std::index_sequence_for<Fields...>{});
+    }
+
+    pop_back();
+}
+
+template <class... Fields>
+void
+SoA<Fields...>::destroyFrom(size_type index)
+{
+    [&]<std::size_t... Is>(std::index_sequence<Is...>)
+    {
+        (std::destroy(data<Is>() + index, data<Is>() + count), ...);
+    }(std::index_sequence_for<Fields...>{});
+}
+
+template <class... Fields>
+void
+SoA<Fields...>::release()
+{
+    clear();
+    if (storage != nullptr)
+        ::operator delete(storage, std::align_val_t{columnAlignment});
+
+    storage = nullptr;
+    columns = {};
+    cap     = 0;
+}
+
+} // namespace sp
+
+
+#endif // SPIRIT_SOA_INL_HPP
@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_FRAMEARENA_HPP
+#define SPIRIT_FRAMEARENA_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+
+namespace sp
+{
+
+class FrameArena;
+
+namespace details
+{
+
+////////////////////////////////////////////////////////////
+// std::pmr adapter of a FrameArena, deallocate is a no-op
+////////////////////////////////////////////////////////////
+class SPIRIT_API FrameArenaResource : public std::pmr::memory_resource
+{
+public:
+
+    explicit FrameArenaResource(FrameArena & arena) : arena{arena} {}
+
+private:
+
+    void *
+    do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void
+    do_deallocate(void *, std::size_t, std::size_t) override
+    {
+    }
+
+    bool
+    do_is_equal(const std::pmr::memory_resource & other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    FrameArena & arena;
+};
+
+} // namespace details
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Memory
+/// \brief Bump allocator for data that lives one or two frames
+///
+/// Allocations bump a pointer in the current frame's buffer and are
+/// never freed individually. nextFrame() switches between two buffers:
+/// memory allocated during frame N stays valid during frame N + 1 and
+/// is reused by frame N + 2. Data can therefore be produced during a
+/// frame and consumed during the next one.
+///
+/// When a frame outgrows its buffer, the arena falls back to heap
+/// blocks and grows the buffer to the high water mark the next time
+/// it is reused, so steady frames never touch the heap.
+///
+/// Attach it to a WindowClock to start a new frame on each tick(), and
+/// use getResource() with std::pmr containers:
+/// \code
+/// sp::FrameArena arena{};
+/// clock.setFrameArena(&arena);
+///
+/// std::pmr::vector<int> scratch{&arena.getResource()};
+/// std::pmr::string label = sp::format(arena.getResource(), "{} fps", fps);
+/// \endcode
+///
+/// Destructors of objects placed in the arena are never called.
+/// Not thread safe, use one arena per thread.
+///
+////////////////////////////////////////////////////////////
+class SPIRIT_API FrameArena
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Arena with two buffers of frameCapacity bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit FrameArena(std::size_t frameCapacity = 1 << 20);
+
+    FrameArena(const FrameArena &) = delete;
+
+    FrameArena &
+    operator=(const FrameArena &) = delete;
+
+    ~FrameArena();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Uninitialized memory valid until the frame after next
+    ///
+    /// alignment must be a power of two. Throws std::bad_alloc.
+    ///
+    ////////////////////////////////////////////////////////////
+    void *
+    allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+    ////////////////////////////////////////////////////////////
+    /// \brief n value-initialized T
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class T>
+    std::span<T>
+    allocateArray(std::size_t n)
+    {
+        static_assert(
+            std::is_trivially_destructible_v<T>,
+            "FrameArena never calls destructors"
+        );
+
+        if (n > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+
+        T * array = static_cast<T *>(this->allocate(n * sizeof(T), alignof(T)));
+        for (std::size_t i = 0; i < n; ++i) ::new (array + i) T();
+
+        return {array, n};
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Starts a new frame, releases the frame before the last one
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    nextFrame();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief memory_resource allocating from this arena
+    ///
+    ////////////////////////////////////////////////////////////
+    std::pmr::memory_resource &
+    getResource()
+    {
+        return resource;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Bytes allocated during the current frame, padding included
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t
+    getFrameUsage() const
+    {
+        return frameUsage;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Largest frame usage so far
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t
+    getHighWaterMark() const
+    {
+        return highWaterMark;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Size of the current frame's buffer
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t
+    getCapacity() const
+    {
+        return buffers[current].capacity;
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Number of heap blocks allocated because a frame overflowed
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t
+    getOverflowCount() const
+    {
+        return overflowCount;
+    }
+
+    sp::Uint64
+    getFrameCount() const
+    {
+        return frameCount;
+    }
+
+private:
+
+    struct Block; // heap block used when a buffer is full
+
+    struct Buffer
+    {
+        std::byte * data     = nullptr;
+        std::size_t capacity = 0;
+        Block * overflow     = nullptr; // most recent first
+    };
+
+    // Bumps in a heap block big enough for size bytes, aligned
+    void *
+    allocateOverflow(std::size_t size, std::size_t alignment);
+
+    void
+    freeOverflow(Buffer & buffer) noexcept;
+
+    // Grows the buffer to the high water mark
+    void
+    grow(Buffer & buffer);
+
+    Buffer buffers[2]{};
+    unsigned current = 0;
+
+    // Bump range of the current frame, in its buffer or last overflow block
+    std::byte * cursor = nullptr;
+    std::byte * end    = nullptr;
+
+    std::size_t frameUsage    = 0;
+    std::size_t highWaterMark = 0;
+    std::size_t overflowCount = 0;
+    sp::Uint64 frameCount     = 0;
+
+    details::FrameArenaResource resource{*this};
+};
+
+
+} // namespace sp
+
+
+#endif // SPIRIT_FRAMEARENA_HPP
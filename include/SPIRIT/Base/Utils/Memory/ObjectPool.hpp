@@ -0,0 +1,297 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SPIRIT_OBJECTPOOL_HPP
+#define SPIRIT_OBJECTPOOL_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace sp
+{
+
+namespace details
+{
+
+struct FreeSlot;
+struct SlabPoolCache;  // a thread's free slots of one pool
+struct SlabPoolCaches; // all the caches of a thread
+
+} // namespace details
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Base
+/// \defgroup Memory Memory
+///
+/// \brief Allocators that avoid contending on the global heap
+///
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \ingroup Memory
+/// \brief Thread safe allocator of fixed size slots
+///
+/// Slots are carved from 64KiB slabs and recycled through free lists:
+/// - Each thread caches up to two batches of free slots, allocate() and
+///   deallocate() only touch that cache in the common case.
+/// - Full batches move between the caches and a shared lock-free stack.
+/// - A mutex is only taken to allocate a new slab.
+///
+/// Slabs are released with the pool, all slots must be deallocated by
+/// then. Slots may be deallocated by another thread than the one that
+/// allocated them.
+///
+////////////////////////////////////////////////////////////
+class SPIRIT_API SlabPool
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Pool of slots of at least slotSize bytes aligned to slotAlign
+    ///
+    ////////////////////////////////////////////////////////////
+    SlabPool(
+        std::size_t slotSize,
+        std::size_t slotAlign = alignof(std::max_align_t)
+    );
+
+    SlabPool(const SlabPool &) = delete;
+
+    SlabPool &
+    operator=(const SlabPool &) = delete;
+
+    ~SlabPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Returns an uninitialized slot, throws std::bad_alloc
+    ///
+    ////////////////////////////////////////////////////////////
+    void *
+    allocate();
+
+    void
+    deallocate(void * slot) noexcept;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Distance between slots, at least the requested size
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t
+    getSlotSize() const
+    {
+        return slotSize;
+    }
+
+    std::size_t
+    getSlabCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Number of slots carved so far, allocated or not
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t
+    capacity() const;
+
+private:
+
+    friend struct details::SlabPoolCaches;
+    typedef details::FreeSlot FreeSlot;
+
+    static constexpr sp::Uint32 batchSize = 32;
+
+    // This thread's cache for this pool, nullptr once the thread's
+    // caches were destroyed (thread_local destructors)
+    details::SlabPoolCache *
+    localCache();
+
+    // Batches are up to batchSize slots linked through FreeSlot::next
+    FreeSlot *
+    popBatch(sp::Uint32 & count);
+
+    void
+    pushBatch(FreeSlot * batch, sp::Uint32 count) noexcept;
+
+    // Carves a new slab, returns one of its batches
+    FreeSlot *
+    grow(sp::Uint32 & count);
+
+    const sp::Uint64 id;
+    const std::size_t slotSize;
+    const std::size_t slotAlign;
+    const std::size_t slabSize;
+
+    // Top of the stack of batches, the high bits of the pointer hold an ABA tag
+    alignas(64) std::atomic<sp::Uint64> batches{0};
+
+    mutable std::mutex slabsMutex{};
+    std::vector<void *> slabs{};
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Memory
+/// \brief Thread safe pool of T
+///
+/// \see SlabPool
+///
+////////////////////////////////////////////////////////////
+template <class T>
+class ObjectPool
+{
+public:
+
+    ObjectPool() : pool{sizeof(T), alignof(T)} {}
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Constructs a T in a free slot
+    ///
+    ////////////////////////////////////////////////////////////
+    template <class... Args>
+    T *
+    create(Args &&... args)
+    {
+        void * slot = pool.allocate();
+        try
+        {
+            return ::new (slot) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            pool.deallocate(slot);
+            throw;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destroys an object obtained from create()
+    ///
+    ////////////////////////////////////////////////////////////
+    void
+    destroy(T * object) noexcept
+    {
+        if (object == nullptr)
+            return;
+
+        std::destroy_at(object);
+        pool.deallocate(object);
+    }
+
+    SlabPool &
+    getPool()
+    {
+        return pool;
+    }
+
+private:
+    SlabPool pool;
+};
+
+
+namespace details
+{
+
+// Shared pools of slots of up to 256 bytes, by multiples of 16 bytes.
+// Returns nullptr for larger or over-aligned requests.
+// These pools are never destroyed, they outlive static objects.
+SPIRIT_API SlabPool *
+sizeClassPool(std::size_t size, std::size_t align);
+
+} // namespace details
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Memory
+/// \brief Standard allocator backed by shared SlabPools
+///
+/// Single objects of up to 256 bytes come from a pool of their size
+/// class, arrays and larger objects from the global heap.
+/// Suits node based containers (std::list, std::map...) well,
+/// their nodes are allocated one at a time.
+///
+/// The allocator is stateless, all instances compare equal.
+///
+////////////////////////////////////////////////////////////
+template <class T>
+class PoolAllocator
+{
+public:
+
+    typedef T value_type;
+
+    PoolAllocator() = default;
+
+    template <class U>
+    PoolAllocator(const PoolAllocator<U> &) noexcept
+    {
+    }
+
+    T *
+    allocate(std::size_t n)
+    {
+        if (n == 1)
+        {
+            if (SlabPool * pool = details::sizeClassPool(sizeof(T), alignof(T)))
+                return static_cast<T *>(pool->allocate());
+        }
+
+        if (n > static_cast<std::size_t>(-1) / sizeof(T))
+            throw std::bad_array_new_length{};
+
+        return static_cast<T *>(
+            ::operator new(n * sizeof(T), std::align_val_t{alignof(T)})
+        );
+    }
+
+    void
+    deallocate(T * ptr, std::size_t n) noexcept
+    {
+        if (n == 1)
+        {
+            if (SlabPool * pool = details::sizeClassPool(sizeof(T), alignof(T)))
+                return pool->deallocate(ptr);
+        }
+
+        ::operator delete(ptr, std::align_val_t{alignof(T)});
+    }
+
+    template <class U>
+    friend bool
+    operator==(const PoolAllocator &, const PoolAllocator<U> &)
+    {
+        return true;
+    }
+};
+
+} // namespace sp
+
+#endif // SPIRIT_OBJECTPOOL_HPP
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_PROFILESCOPE_HPP
+#define SPIRIT_PROFILESCOPE_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+
+#include <cstdio>
+#include <ostream>
+
+#if __has_include(<source_location>)
+#    include <source_location>
+#elif __has_include(<experimental/source_location>)
+#    include <experimental/source_location>
+#else
+#    error "No std::source_location is available"
+#endif
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Base
+/// \defgroup Profiling Profiling
+/// \brief Lightweight instrumentation of scopes
+///
+////////////////////////////////////////////////////////////
+
+
+namespace sp
+{
+
+namespace details
+{
+
+#if __has_include(<source_location>)
+typedef std::source_location SourceLocation;
+#elif __has_include(<experimental/source_location>)
+typedef std::experimental::source_location SourceLocation;
+#endif
+
+// Appends an event to the calling thread's trace buffer, never locks
+// except on the thread's first event. Dropped past the trace capacity.
+SPIRIT_API void
+recordTraceEvent(const char * name, const SourceLocation & loc, char phase);
+
+} // namespace details
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Records a trace event when constructed and when destroyed
+///
+/// Events are timestamped with TscClock and appended to a buffer owned
+/// by the calling thread, recording takes a few dozen nanoseconds and
+/// never blocks other threads.
+/// Export them with writeChromeTrace() to view the scopes in
+/// chrome://tracing or Perfetto. Long running programs should export
+/// with drainChromeTrace() periodically, events past the trace capacity
+/// are dropped (see setTraceCapacity).
+///
+/// name must outlive the trace (ie a string literal), it defaults to
+/// the enclosing function's name.
+///
+/// Prefer SPIRIT_PROFILE_SCOPE and SPIRIT_PROFILE_FUNCTION, which are
+/// removed unless SPIRIT_PROFILE is enabled.
+///
+////////////////////////////////////////////////////////////
+class ProfileScope
+{
+public:
+
+    explicit ProfileScope(
+        const char * name                = nullptr,
+        details::SourceLocation location = details::SourceLocation::current()
+    )
+        : name{name ? name : location.function_name()}
+    {
+        details::recordTraceEvent(this->name, location, 'B');
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+
+    ProfileScope &
+    operator=(const ProfileScope &) = delete;
+
+    ~ProfileScope()
+    {
+        details::recordTraceEvent(name, details::SourceLocation{}, 'E');
+    }
+
+private:
+
+    const char * name;
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Writes all recorded events in the Chrome trace event format
+///
+/// Threads may keep recording while the trace is written, their newest
+/// events may be missing from it.
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API void
+writeChromeTrace(std::ostream & os);
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Writes the recorded events then discards them
+///
+/// Frees the memory of the written events, threads may keep recording
+/// meanwhile. Successive drains write consecutive parts of the trace.
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API void
+drainChromeTrace(std::ostream & os);
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Writes the trace to file through an OutFileBuf
+///
+/// The file is not closed, returns false if writing failed.
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API bool
+writeChromeTrace(FILE * file);
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Number of events recorded by all threads
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API std::size_t
+traceEventCount();
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Discards all recorded events
+///
+/// Threads may keep recording meanwhile, their newest events may
+/// be kept.
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API void
+clearTrace();
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Bounds the memory of recorded events, about 1M by default
+///
+/// Counts the events of all threads, rounded up to chunks of 1024.
+/// Events recorded past the capacity are dropped until the trace is
+/// drained or cleared. Each thread may keep one chunk over capacity.
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API void
+setTraceCapacity(std::size_t maxEvents);
+
+SPIRIT_API std::size_t
+getTraceCapacity();
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Number of events dropped because the trace was full
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API sp::Uint64
+droppedTraceEventCount();
+
+} // namespace sp
+
+
+#define SPIRIT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define SPIRIT_PROFILE_CONCAT(a, b)      SPIRIT_PROFILE_CONCAT_IMPL(a, b)
+
+#if SPIRIT_PROFILE
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Profiles the rest of the enclosing scope under name
+///
+////////////////////////////////////////////////////////////
+#    define SPIRIT_PROFILE_SCOPE(name) \
+        const sp::ProfileScope SPIRIT_PROFILE_CONCAT(spiritProfileScope, __LINE__) {name}
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Profiles the rest of the enclosing function
+///
+////////////////////////////////////////////////////////////
+#    define SPIRIT_PROFILE_FUNCTION() \
+        const sp::ProfileScope SPIRIT_PROFILE_CONCAT(spiritProfileScope, __LINE__) {}
+
+#else
+
+#    define SPIRIT_PROFILE_SCOPE(name) static_cast<void>(0)
+#    define SPIRIT_PROFILE_FUNCTION()  static_cast<void>(0)
+
+#endif
+
+
+#endif // SPIRIT_PROFILESCOPE_HPP
@@ -0,0 +1,222 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_PROFILER_HPP
+#define SPIRIT_PROFILER_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "SPIRIT/Base/Utils/Profiling/ProfileScope.hpp"
+#include "SPIRIT/Base/Utils/Time/Timer.hpp"
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace sp
+{
+
+namespace details
+{
+
+struct ProfilerNode;
+
+// Makes name's node (a child of the thread's current node) current
+SPIRIT_API ProfilerNode *
+enterProfilerNode(const char * name);
+
+// Accounts for a call of node and makes its parent current
+SPIRIT_API void
+exitProfilerNode(ProfilerNode * node, std::chrono::nanoseconds elapsed);
+
+} // namespace details
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Statistics of a scope, merged over all threads
+///
+/// Children are the scopes entered from this one, sorted by
+/// decreasing inclusive time.
+///
+/// Inclusive time counts the time spent in children, exclusive
+/// time does not.
+///
+////////////////////////////////////////////////////////////
+struct ProfileNode
+{
+    std::string name{};
+
+    sp::Uint64 calls = 0;
+
+    std::chrono::nanoseconds inclusive{0};
+    std::chrono::nanoseconds exclusive{0};
+    std::chrono::nanoseconds min{0};
+    std::chrono::nanoseconds max{0};
+
+    std::vector<ProfileNode> children{};
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Child named name, nullptr if there is none
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] const ProfileNode *
+    find(std::string_view childName) const
+    {
+        for (const ProfileNode & child : children)
+        {
+            if (child.name == childName)
+                return &child;
+        }
+
+        return nullptr;
+    }
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Aggregates the time spent in a scope into the profile
+///
+/// Each thread keeps a call tree of the scopes it entered, a scope's
+/// statistics (calls, inclusive and exclusive time, min and max)
+/// are accumulated in its node. Unlike ProfileScope, memory does not
+/// grow with the number of calls, making it suitable for always-on
+/// profiling.
+///
+/// name must outlive the profile (ie a string literal), it defaults
+/// to the enclosing function's name.
+///
+/// See collectProfile() and logProfile().
+///
+////////////////////////////////////////////////////////////
+class AggregateScope
+{
+public:
+
+    explicit AggregateScope(
+        const char * name                = nullptr,
+        details::SourceLocation location = details::SourceLocation::current()
+    )
+        : node{details::enterProfilerNode(name ? name : location.function_name())}
+    {
+    }
+
+    AggregateScope(const AggregateScope &) = delete;
+
+    AggregateScope &
+    operator=(const AggregateScope &) = delete;
+
+    ~AggregateScope()
+    {
+        details::exitProfilerNode(node, timer.getElapsed());
+    }
+
+private:
+
+    details::ProfilerNode * node;
+    sp::TscTimer timer{};
+};
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Merges the call trees of all threads
+///
+/// Scopes with the same name and parents are merged. The returned
+/// root is unnamed, its children are the outermost scopes.
+///
+/// Scopes that are still open are missing their ongoing call.
+///
+/// \param reset Also clears the statistics, for periodic reports
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API ProfileNode
+collectProfile(bool reset = false);
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Clears the statistics of all threads
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API void
+resetProfile();
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Formats the profile as an indented table
+///
+/// With colors, lines are styled with the defaultLevelColor()
+/// palette according to their share of the total time,
+/// hot scopes use the err and warn colors.
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API std::string
+formatProfile(const ProfileNode & root, bool colors = true);
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Collects the profile and logs it through spiritLogger()
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API void
+logProfile(bool reset = false);
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Calls logProfile(true) if period elapsed since the last report
+///
+/// Meant to be called from a main loop, returns true if the profile
+/// was logged.
+///
+////////////////////////////////////////////////////////////
+SPIRIT_API bool
+logProfileEvery(std::chrono::nanoseconds period);
+
+} // namespace sp
+
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Aggregates the rest of the enclosing scope under name
+///
+/// Unlike SPIRIT_PROFILE_SCOPE, this is always enabled.
+///
+////////////////////////////////////////////////////////////
+#define SPIRIT_AGGREGATE_SCOPE(name) \
+    const sp::AggregateScope SPIRIT_PROFILE_CONCAT(spiritAggregateScope, __LINE__) {name}
+
+////////////////////////////////////////////////////////////
+/// \ingroup Profiling
+/// \brief Aggregates the rest of the enclosing function
+///
+////////////////////////////////////////////////////////////
+#define SPIRIT_AGGREGATE_FUNCTION() \
+    const sp::AggregateScope SPIRIT_PROFILE_CONCAT(spiritAggregateScope, __LINE__) {}
+
+
+#endif // SPIRIT_PROFILER_HPP
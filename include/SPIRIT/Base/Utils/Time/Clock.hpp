@@ -27,13 +27,15 @@
 #define SPIRIT_CLOCK_HPP
 
 #include "SPIRIT/Base/Configuration/config.hpp"
+#include "RollingStats.hpp"
 #include "Timer.hpp"
-#include <queue>
 
 
 namespace sp
 {
 
+class FrameArena;
+
 class Clock
 {
 public:
@@ -45,9 +47,25 @@ public:
     Nanoseconds
     getCurrentDt() const;
 
+    //////////////////////////////////////////////////////////
+    /// \brief Ends the current tick, returns its duration
+    ///
+    /// With a minimum tick period, waits for the tick's deadline.
+    /// Deadlines are absolute and a period apart, so the average tick
+    /// rate matches the period exactly.
+    //////////////////////////////////////////////////////////
     Nanoseconds
     tick();
 
+    //////////////////////////////////////////////////////////
+    /// \brief Starts a new tick now, without ending the current one
+    ///
+    /// Does not wait nor record statistics, the pacing schedule
+    /// restarts from now.
+    //////////////////////////////////////////////////////////
+    void
+    restart();
+
     Nanoseconds
     getAverageTick() const;
 
@@ -63,13 +81,53 @@ public:
         return this->tickPeriod;
     }
 
+    //////////////////////////////////////////////////////////
+    /// \brief Time spent spinning before a tick's deadline
+    ///
+    /// tick() sleeps until the deadline minus this period, then yields
+    /// until the deadline. Longer spins absorb more of the scheduler's
+    /// wake up latency at the cost of cpu time.
+    //////////////////////////////////////////////////////////
+    void
+    setSpinPeriod(Nanoseconds spin);
+
+    Nanoseconds
+    getSpinPeriod() const
+    {
+        return this->spinPeriod;
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Statistics over the last ticks (mean, min, max, percentiles...)
+    ///
+    /// Updated in O(1) by each tick, the window holds 10 ticks by default.
+    //////////////////////////////////////////////////////////
+    const RollingStats &
+    getStats() const
+    {
+        return this->ticks;
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Number of ticks kept for statistics, clears them
+    //////////////////////////////////////////////////////////
+    void
+    setStatsWindow(std::size_t nTicks)
+    {
+        this->ticks.setWindowSize(nTicks);
+    }
+
 private:
     Timer timer{};
 
     Nanoseconds tickPeriod{0}; // don't wait on ticks
+    Nanoseconds spinPeriod{std::chrono::microseconds{200}};
 
-    // TODO: use a circular buffer instead
-    std::deque<Nanoseconds> ticks{};
+    // Ticks are paced on absolute deadlines, each a tickPeriod after the last
+    std::chrono::steady_clock::time_point deadline{};
+    bool isPaced = false;
+
+    RollingStats ticks{};
 };
 
 
@@ -79,7 +137,38 @@ public:
 
     using Clock::Clock;
     using Clock::getCurrentDt;
-    using Clock::tick;
+    using Clock::getMinimumTickPeriod;
+    using Clock::getSpinPeriod;
+    using Clock::getStats;
+    using Clock::restart;
+    using Clock::setSpinPeriod;
+    using Clock::setStatsWindow;
+
+    //////////////////////////////////////////////////////////
+    /// \brief Ends the current frame, returns its duration
+    ///
+    /// Starts a new frame in the attached FrameArena, if any.
+    /// restart() does not.
+    //////////////////////////////////////////////////////////
+    Nanoseconds
+    tick();
+
+    //////////////////////////////////////////////////////////
+    /// \brief Arena whose nextFrame() is called by each tick()
+    ///
+    /// The arena must outlive the clock, or be detached with nullptr.
+    //////////////////////////////////////////////////////////
+    void
+    setFrameArena(FrameArena * arena)
+    {
+        this->frameArena = arena;
+    }
+
+    FrameArena *
+    getFrameArena() const
+    {
+        return this->frameArena;
+    }
 
     std::chrono::nanoseconds
     getFrameTime() const
@@ -99,7 +188,7 @@ public:
     setFps(float fps = 0)
     {
         this->setMinimumTickPeriod(std::chrono::nanoseconds{
-            (sp::Int32)(fps == 0 ? 0 : 1e9 / fps)});
+            (sp::Int64)(fps == 0 ? 0 : 1e9 / fps)});
     }
 
 
@@ -108,6 +197,9 @@ public:
     {
         this->setMinimumTickPeriod(dt);
     }
+
+private:
+    FrameArena * frameArena = nullptr;
 };
 
 
@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_FIXEDTIMESTEP_HPP
+#define SPIRIT_FIXEDTIMESTEP_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "Clock.hpp"
+
+#include <chrono>
+
+
+namespace sp
+{
+
+//////////////////////////////////////////////////////////
+/// \brief Drives a simulation with fixed steps and a variable frame rate
+///
+/// Each frame adds its duration to an accumulator, update() is then
+/// called once per whole step in the accumulator, and render()
+/// receives the fraction of a step left over (alpha, in [0, 1)) to
+/// interpolate between the last two simulation states.
+///
+/// When updates are slower than real time, the accumulator would grow
+/// without bounds (the spiral of death): at most maxStepsPerFrame
+/// steps are run per frame and the excess time is dropped. Dropped
+/// steps are counted, the simulation then runs slower than real time.
+///
+/// \code
+/// sp::FixedTimestep loop{std::chrono::milliseconds{10}};
+/// loop.getClock().setFps(144);
+///
+/// while (running)
+/// {
+///     loop.frame(
+///         [&](std::chrono::nanoseconds dt) { world.update(dt); },
+///         [&](double alpha) { renderer.draw(world, alpha); }
+///     );
+/// }
+/// \endcode
+///
+//////////////////////////////////////////////////////////
+class SPIRIT_API FixedTimestep
+{
+public:
+
+    typedef std::chrono::nanoseconds Nanoseconds;
+
+    explicit FixedTimestep(Nanoseconds step, sp::Int32 maxStepsPerFrame = 5);
+
+    //////////////////////////////////////////////////////////
+    /// \brief Ticks the clock, runs the due updates then renders
+    ///
+    /// The clock waits for its minimum frame time (see WindowClock::setFps).
+    ///
+    /// \return The number of updates run
+    //////////////////////////////////////////////////////////
+    template <class Update, class Render>
+    sp::Int32
+    frame(Update && update, Render && render)
+    {
+        sp::Int32 nSteps = advance(clock.tick());
+
+        for (sp::Int32 i = 0; i < nSteps; ++i)
+            update(step);
+
+        render(alpha());
+        return nSteps;
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Accumulates a frame's duration, returns the steps to run
+    ///
+    /// For loops that don't use frame(), the returned number of steps
+    /// is already capped and the accumulator consumed.
+    //////////////////////////////////////////////////////////
+    sp::Int32
+    advance(Nanoseconds frameTime);
+
+    //////////////////////////////////////////////////////////
+    /// \brief Fraction of a step in the accumulator, in [0, 1)
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] double
+    alpha() const
+    {
+        return static_cast<double>(accumulator.count()) / static_cast<double>(step.count());
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Empties the accumulator and restarts the frame
+    ///
+    /// Call after a long pause (ie loading) that should not be simulated.
+    //////////////////////////////////////////////////////////
+    void
+    reset();
+
+    [[nodiscard]] Nanoseconds
+    getStep() const
+    {
+        return step;
+    }
+
+    void
+    setStep(Nanoseconds newStep);
+
+    [[nodiscard]] sp::Int32
+    getMaxStepsPerFrame() const
+    {
+        return maxSteps;
+    }
+
+    void
+    setMaxStepsPerFrame(sp::Int32 maxStepsPerFrame);
+
+    //////////////////////////////////////////////////////////
+    /// \brief Clock timing the frames, its statistics are frame times
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] WindowClock &
+    getClock()
+    {
+        return clock;
+    }
+
+    [[nodiscard]] const WindowClock &
+    getClock() const
+    {
+        return clock;
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Number of updates run since construction
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] sp::Uint64
+    getStepCount() const
+    {
+        return stepCount;
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Number of steps dropped by the cap since construction
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] sp::Uint64
+    getDroppedSteps() const
+    {
+        return droppedSteps;
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Number of steps dropped by the last frame
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] sp::Int64
+    getLastDroppedSteps() const
+    {
+        return lastDroppedSteps;
+    }
+
+private:
+
+    WindowClock clock{};
+
+    Nanoseconds step;
+    Nanoseconds accumulator{0};
+    sp::Int32 maxSteps;
+
+    sp::Uint64 stepCount       = 0;
+    sp::Uint64 droppedSteps    = 0;
+    sp::Int64 lastDroppedSteps = 0;
+};
+
+} // namespace sp
+
+
+#endif // SPIRIT_FIXEDTIMESTEP_HPP
@@ -0,0 +1,276 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_HISTOGRAM_HPP
+#define SPIRIT_HISTOGRAM_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "RollingStats.hpp"
+#include "Timer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sp
+{
+
+namespace details
+{
+
+struct HistogramShard;
+
+// Threads are numbered on first call, a thread uses the same shard
+// index in all sharded counters
+SPIRIT_API std::size_t
+threadShardIndex();
+
+} // namespace details
+
+
+//////////////////////////////////////////////////////////
+/// \brief Formats a duration with a unit suited to its magnitude
+///
+/// ie 850ns, 12.35us, 1.20ms, 3.00s
+//////////////////////////////////////////////////////////
+SPIRIT_API std::string
+formatDuration(std::chrono::nanoseconds duration);
+
+
+//////////////////////////////////////////////////////////
+/// \brief Distribution of durations, not thread safe
+///
+/// Durations are counted in log-linear buckets (32 per power of two),
+/// percentiles are within ~1.5% of the exact value while memory stays
+/// constant. Durations above 2^40 ns (~18 minutes) share the last
+/// bucket. Count, mean, min and max are exact.
+///
+/// Obtained from Histogram::snapshot(), or used directly by a single
+/// thread.
+///
+//////////////////////////////////////////////////////////
+class SPIRIT_API HistogramSnapshot
+{
+public:
+
+    typedef std::chrono::nanoseconds Nanoseconds;
+    typedef details::LogLinearBuckets<5, 40> Buckets;
+
+    HistogramSnapshot() = default;
+
+    void
+    record(Nanoseconds value, sp::Uint64 n = 1);
+
+    //////////////////////////////////////////////////////////
+    /// \brief Adds other's durations to this distribution
+    //////////////////////////////////////////////////////////
+    void
+    merge(const HistogramSnapshot & other);
+
+    void
+    clear();
+
+    [[nodiscard]] sp::Uint64
+    count() const
+    {
+        return total;
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Number of durations in a bucket, see Buckets
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] sp::Uint64
+    bucketCount(sp::Int32 bucket) const
+    {
+        return counts.empty() ? 0 : counts[bucket];
+    }
+
+    // All statistics are 0 when empty
+
+    [[nodiscard]] Nanoseconds
+    sum() const
+    {
+        return Nanoseconds{sumValue};
+    }
+
+    [[nodiscard]] Nanoseconds
+    mean() const;
+
+    [[nodiscard]] Nanoseconds
+    min() const;
+
+    [[nodiscard]] Nanoseconds
+    max() const;
+
+    //////////////////////////////////////////////////////////
+    /// \brief Approximate percentile, p is in [0, 100]
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] Nanoseconds
+    percentile(double p) const;
+
+    [[nodiscard]] Nanoseconds
+    p50() const
+    {
+        return percentile(50);
+    }
+
+    [[nodiscard]] Nanoseconds
+    p90() const
+    {
+        return percentile(90);
+    }
+
+    [[nodiscard]] Nanoseconds
+    p99() const
+    {
+        return percentile(99);
+    }
+
+    [[nodiscard]] Nanoseconds
+    p999() const
+    {
+        return percentile(99.9);
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Summary, percentiles and a bar chart per power of two
+    ///
+    /// \param barWidth Length of the longest bar
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] std::string
+    render(sp::Int32 barWidth = 40) const;
+
+private:
+
+    friend class Histogram;
+
+    // allocated on first record, snapshots of idle histograms are cheap
+    std::vector<sp::Uint64> counts{};
+
+    sp::Uint64 total   = 0;
+    sp::Int64 sumValue = 0;
+    sp::Int64 minValue = 0;
+    sp::Int64 maxValue = 0;
+};
+
+
+//////////////////////////////////////////////////////////
+/// \brief Distribution of durations, recorded concurrently
+///
+/// record() is lock-free: threads increment atomic counters in shards,
+/// each thread uses its own shard unless there are more threads than
+/// shards. Shards are allocated on first use.
+///
+/// Readers merge the shards into a HistogramSnapshot:
+/// \code
+/// sp::Histogram frameTimes{};
+///
+/// // in the main loop
+/// frameTimes.record(clock.tick());
+///
+/// // periodically
+/// sp::HistogramSnapshot last = frameTimes.snapshot(true);
+/// sp::spiritLog() << sp::Info{"Frame times\n{}", last.render()};
+/// \endcode
+///
+//////////////////////////////////////////////////////////
+class SPIRIT_API Histogram
+{
+public:
+
+    typedef std::chrono::nanoseconds Nanoseconds;
+
+    //////////////////////////////////////////////////////////
+    /// \brief nShards defaults to the number of hardware threads
+    //////////////////////////////////////////////////////////
+    explicit Histogram(std::size_t nShards = 0);
+
+    ~Histogram();
+
+    Histogram(const Histogram &) = delete;
+
+    Histogram &
+    operator=(const Histogram &) = delete;
+
+    //////////////////////////////////////////////////////////
+    /// \brief Records a duration, negative durations count as 0
+    //////////////////////////////////////////////////////////
+    void
+    record(Nanoseconds value);
+
+    //////////////////////////////////////////////////////////
+    /// \brief Records the timer's elapsed time
+    //////////////////////////////////////////////////////////
+    template <class ClockType>
+    void
+    record(const BasicTimer<ClockType> & timer)
+    {
+        record(timer.getElapsed());
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Merges the shards
+    ///
+    /// Each shard's counters are switched, then taken once the records
+    /// in progress are done: a concurrent record() is entirely in this
+    /// snapshot or entirely in the next one, count, sum and extremes
+    /// always agree. Waits for those records, which are short.
+    ///
+    /// \param reset Discards the durations taken, the next snapshot
+    ///     only has those recorded after this one.
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] HistogramSnapshot
+    snapshot(bool reset = false);
+
+    void
+    reset();
+
+    [[nodiscard]] std::size_t
+    shardCount() const
+    {
+        return nShards;
+    }
+
+private:
+
+    details::HistogramShard &
+    shard();
+
+    std::size_t nShards;
+    std::unique_ptr<std::atomic<details::HistogramShard *>[]> shards;
+
+    // Durations taken from the shards and not reset yet
+    std::mutex snapshotMutex{};
+    HistogramSnapshot retained{};
+};
+
+} // namespace sp
+
+
+#endif // SPIRIT_HISTOGRAM_HPP
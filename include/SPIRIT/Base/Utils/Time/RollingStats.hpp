@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_ROLLINGSTATS_HPP
+#define SPIRIT_ROLLINGSTATS_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <vector>
+
+namespace sp
+{
+
+namespace details
+{
+
+////////////////////////////////////////////////////////////
+/// \brief Log-linear bucketing of positive integers
+///
+/// Values are grouped by power of two, each power of two is split in
+/// subBuckets linear sub-buckets. The relative error of a bucket's
+/// midpoint is at most 1 / (2 * subBuckets).
+///
+////////////////////////////////////////////////////////////
+template <sp::Int32 subBucketBits, sp::Int32 maxValueBits>
+struct LogLinearBuckets
+{
+    static constexpr sp::Int32 subBuckets = 1 << subBucketBits;
+    static constexpr sp::Int32 count      = (maxValueBits - subBucketBits + 1) * subBuckets;
+
+    static constexpr sp::Int32
+    indexOf(sp::Uint64 value)
+    {
+        if (value < static_cast<sp::Uint64>(subBuckets))
+            return static_cast<sp::Int32>(value);
+
+        sp::Int32 msb = 63 - std::countl_zero(value);
+
+        if (msb >= maxValueBits)
+            return count - 1;
+
+        sp::Int32 shift = msb - subBucketBits;
+        sp::Int32 sub   = static_cast<sp::Int32>(value >> shift) - subBuckets;
+
+        return (shift + 1) * subBuckets + sub;
+    }
+
+    // Smallest value of the bucket
+    static constexpr sp::Uint64
+    lowerBound(sp::Int32 index)
+    {
+        if (index < subBuckets)
+            return static_cast<sp::Uint64>(index);
+
+        sp::Int32 shift = index / subBuckets - 1;
+        sp::Int32 sub   = index % subBuckets;
+        return static_cast<sp::Uint64>(subBuckets + sub) << shift;
+    }
+
+    static constexpr sp::Uint64
+    width(sp::Int32 index)
+    {
+        return index < 2 * subBuckets ? 1 : sp::Uint64{1} << (index / subBuckets - 1);
+    }
+};
+
+} // namespace details
+
+
+//////////////////////////////////////////////////////////
+/// \brief Statistics over a sliding window of durations
+///
+/// Keeps the last windowSize() durations in a ring buffer, along with a
+/// running sum, sum of squares and a compact histogram.
+///
+/// push() is O(1), mean and standard deviation are O(1),
+/// percentiles walk the histogram (a few hundred counters) and are
+/// approximate (within ~3%), min and max are exact.
+///
+//////////////////////////////////////////////////////////
+class SPIRIT_API RollingStats
+{
+public:
+
+    typedef std::chrono::nanoseconds Nanoseconds;
+
+    static constexpr std::size_t defaultWindowSize = 10;
+
+    explicit RollingStats(std::size_t windowSize = defaultWindowSize);
+
+    void
+    push(Nanoseconds value);
+
+    //////////////////////////////////////////////////////////
+    /// \brief Changes the number of durations kept, clears the statistics
+    //////////////////////////////////////////////////////////
+    void
+    setWindowSize(std::size_t windowSize);
+
+    [[nodiscard]] std::size_t
+    windowSize() const
+    {
+        return window.size();
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Number of durations in the window
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return count;
+    }
+
+    void
+    clear();
+
+    //////////////////////////////////////////////////////////
+    /// \brief Last pushed duration, 0 if empty
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] Nanoseconds
+    last() const;
+
+    // All statistics are 0 when empty
+
+    [[nodiscard]] Nanoseconds
+    mean() const;
+
+    [[nodiscard]] Nanoseconds
+    stddev() const;
+
+    [[nodiscard]] Nanoseconds
+    min() const;
+
+    [[nodiscard]] Nanoseconds
+    max() const;
+
+    //////////////////////////////////////////////////////////
+    /// \brief Approximate percentile, p is in [0, 100]
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] Nanoseconds
+    percentile(double p) const;
+
+    [[nodiscard]] Nanoseconds
+    p50() const
+    {
+        return percentile(50);
+    }
+
+    [[nodiscard]] Nanoseconds
+    p95() const
+    {
+        return percentile(95);
+    }
+
+    [[nodiscard]] Nanoseconds
+    p99() const
+    {
+        return percentile(99);
+    }
+
+private:
+
+    // 16 sub-buckets per power of two, up to 2^40 ns (~18 minutes)
+    typedef details::LogLinearBuckets<4, 40> Buckets;
+
+    void
+    recomputeExtremes() const;
+
+    std::vector<sp::Int64> window;
+    std::size_t head  = 0; // next slot to write
+    std::size_t count = 0;
+
+    sp::Int64 sum     = 0;
+    double sumSquares = 0;
+
+    std::array<sp::Uint32, Buckets::count> histogram{};
+
+    // recomputed when the current extreme leaves the window
+    mutable sp::Int64 minValue    = 0;
+    mutable sp::Int64 maxValue    = 0;
+    mutable bool extremesAreDirty = false;
+};
+
+} // namespace sp
+
+
+#endif // SPIRIT_ROLLINGSTATS_HPP
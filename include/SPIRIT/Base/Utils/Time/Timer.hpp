@@ -26,6 +26,8 @@
 #ifndef SPIRIT_TIMER_HPP
 #define SPIRIT_TIMER_HPP
 
+#include "TscClock.hpp"
+
 #include <chrono>
 
 
@@ -36,15 +38,21 @@ namespace sp
 //////////////////////////////////////////////////////////
 /// \brief High resolution Timer for simple Benchmarking
 ///
+/// ClockType is a standard Clock (ie std::chrono::steady_clock),
+/// see Timer and TscTimer.
+///
 //////////////////////////////////////////////////////////
-class Timer
+template <class ClockType>
+class BasicTimer
 {
 public:
 
+    typedef ClockType ClockT;
+
     //////////////////////////////////////////////////////////
     /// \brief Start a timer (stopwatch)
     //////////////////////////////////////////////////////////
-    Timer(bool startNow = true);
+    BasicTimer(bool startNow = true);
 
 
     void
@@ -52,7 +60,9 @@ public:
     {
         if (!paused)
         {
-            elapsed += std::chrono::high_resolution_clock::now() - time;
+            elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                ClockT::now() - time
+            );
             paused = true;
         }
     }
@@ -63,7 +73,7 @@ public:
     {
         if (paused)
         {
-            time   = std::chrono::high_resolution_clock::now();
+            time   = ClockT::now();
             paused = false;
         }
     }
@@ -125,14 +135,28 @@ public:
 
 protected:
 
-    std::chrono::time_point<std::chrono::high_resolution_clock, std::chrono::nanoseconds>
-        time;
+    typename ClockT::time_point time{};
 
     std::chrono::nanoseconds elapsed{0};
     bool paused = true;
 };
 
+
+//////////////////////////////////////////////////////////
+/// \brief Timer using std::chrono::high_resolution_clock
+///
+//////////////////////////////////////////////////////////
+typedef BasicTimer<std::chrono::high_resolution_clock> Timer;
+
+//////////////////////////////////////////////////////////
+/// \brief Timer reading the time stamp counter, for very short scopes
+///
+/// \see TscClock
+//////////////////////////////////////////////////////////
+typedef BasicTimer<sp::TscClock> TscTimer;
+
 } // namespace sp
 
+#include "Timer_inl.hpp"
 
 #endif // SPIRIT_TIMER_HPP
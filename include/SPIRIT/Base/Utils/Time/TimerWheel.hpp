@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_TIMERWHEEL_HPP
+#define SPIRIT_TIMERWHEEL_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+#include "Clock.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace sp
+{
+
+//////////////////////////////////////////////////////////
+/// \brief Schedules timeouts in O(1), fires them as time advances
+///
+/// Time advances in ticks of a fixed resolution, explicitly with
+/// advance() (ie with Clock::tick() in a main loop) or by a
+/// TimerWheelThread.
+///
+/// Timeouts are kept in a hierarchy of wheels of 64 slots, each wheel
+/// covering 64 times the range of the previous one: scheduling and
+/// cancelling are O(1), a timeout cascades to finer wheels a few times
+/// (once per 6 bits of its delay in ticks) before firing.
+/// Stretches of ticks without timeouts due are skipped.
+///
+/// A timeout fires in the advance() during which its delay elapses,
+/// never earlier, at most one resolution late.
+///
+/// Callbacks may schedule and cancel timeouts. Not thread safe.
+///
+/// \code
+/// sp::TimerWheel timeouts{std::chrono::milliseconds{1}};
+/// auto id = timeouts.schedule(std::chrono::seconds{5}, [&]() { disconnect(peer); });
+///
+/// // when a message is received:
+/// timeouts.cancel(id);
+///
+/// // in the main loop:
+/// timeouts.advance(clock.tick());
+/// \endcode
+///
+//////////////////////////////////////////////////////////
+class SPIRIT_API TimerWheel
+{
+public:
+
+    typedef std::chrono::nanoseconds Nanoseconds;
+    typedef std::function<void()> Callback;
+
+    //////////////////////////////////////////////////////////
+    /// \brief Identifies a scheduled timeout, 0 is never used
+    //////////////////////////////////////////////////////////
+    typedef sp::Uint64 TimerId;
+
+    explicit TimerWheel(Nanoseconds resolution = std::chrono::milliseconds{1});
+
+    //////////////////////////////////////////////////////////
+    /// \brief Calls callback once delay has elapsed
+    ///
+    /// Delays are clamped to 2^62 ticks, over 146 years at a
+    /// nanosecond resolution.
+    //////////////////////////////////////////////////////////
+    TimerId
+    schedule(Nanoseconds delay, Callback callback);
+
+    //////////////////////////////////////////////////////////
+    /// \brief Returns false if the timeout already fired or was cancelled
+    //////////////////////////////////////////////////////////
+    bool
+    cancel(TimerId id);
+
+    //////////////////////////////////////////////////////////
+    /// \brief Advances time, firing the timeouts that are due
+    ///
+    /// Fractions of the resolution are carried to the next call.
+    ///
+    /// \return The number of fired timeouts
+    //////////////////////////////////////////////////////////
+    std::size_t
+    advance(Nanoseconds elapsed);
+
+    //////////////////////////////////////////////////////////
+    /// \brief Cancels all timeouts
+    //////////////////////////////////////////////////////////
+    void
+    clear();
+
+    //////////////////////////////////////////////////////////
+    /// \brief Number of scheduled timeouts
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] std::size_t
+    size() const
+    {
+        return count;
+    }
+
+    [[nodiscard]] Nanoseconds
+    getResolution() const
+    {
+        return resolution;
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Time advanced since construction
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] Nanoseconds
+    getTime() const
+    {
+        return static_cast<sp::Int64>(now) * resolution + remainder;
+    }
+
+private:
+
+    static constexpr sp::Int32 slotBits  = 6;
+    static constexpr sp::Int32 nSlots    = 1 << slotBits;
+    static constexpr sp::Int32 nLevels   = (64 + slotBits - 1) / slotBits; // all of a tick's bits
+    static constexpr sp::Uint64 maxTicks = sp::Uint64{1} << 62;
+    static constexpr sp::Uint32 nil      = 0xFFFFFFFF;
+
+    struct Node
+    {
+        Callback callback{};
+        sp::Uint64 expiry     = 0;
+        sp::Uint32 prev       = nil;
+        sp::Uint32 next       = nil; // next free node when unused
+        sp::Uint32 generation = 1;
+        sp::Uint32 list       = nil; // level * nSlots + slot, nil when unused
+    };
+
+    void
+    insert(sp::Uint32 index);
+
+    void
+    unlink(sp::Uint32 index);
+
+    void
+    release(sp::Uint32 index);
+
+    // First tick at which a timeout fires or cascades
+    sp::Uint64
+    nextExpiry() const;
+
+    // Moves to now + 1, returns the number of fired timeouts
+    std::size_t
+    tick();
+
+    Nanoseconds resolution;
+    Nanoseconds remainder{0};
+    sp::Uint64 now = 0;
+
+    std::vector<Node> nodes{};
+    sp::Uint32 freeList = nil;
+    std::size_t count   = 0;
+
+    std::array<sp::Uint32, nSlots * nLevels> heads{};
+    std::array<sp::Uint64, nLevels> occupied{}; // a bit per non-empty slot
+};
+
+
+//////////////////////////////////////////////////////////
+/// \brief TimerWheel advanced by its own thread
+///
+/// The thread ticks a Clock at the wheel's resolution and runs the
+/// callbacks, which may schedule and cancel timeouts. Other threads'
+/// calls wait for the callbacks to return.
+///
+//////////////////////////////////////////////////////////
+class SPIRIT_API TimerWheelThread
+{
+public:
+
+    typedef TimerWheel::Nanoseconds Nanoseconds;
+    typedef TimerWheel::Callback Callback;
+    typedef TimerWheel::TimerId TimerId;
+
+    //////////////////////////////////////////////////////////
+    /// \brief Starts the thread
+    //////////////////////////////////////////////////////////
+    explicit TimerWheelThread(Nanoseconds resolution = std::chrono::milliseconds{1});
+
+    TimerWheelThread(const TimerWheelThread &) = delete;
+
+    TimerWheelThread &
+    operator=(const TimerWheelThread &) = delete;
+
+    ~TimerWheelThread();
+
+    TimerId
+    schedule(Nanoseconds delay, Callback callback);
+
+    bool
+    cancel(TimerId id);
+
+    [[nodiscard]] std::size_t
+    size() const;
+
+    //////////////////////////////////////////////////////////
+    /// \brief Stops the thread, pending timeouts don't fire
+    //////////////////////////////////////////////////////////
+    void
+    stop();
+
+private:
+
+    void
+    run();
+
+    mutable std::recursive_mutex mutex{};
+    TimerWheel wheel;
+
+    sp::Clock clock;
+    std::atomic<bool> running{true};
+    std::thread thread;
+};
+
+} // namespace sp
+
+
+#endif // SPIRIT_TIMERWHEEL_HPP
@@ -23,64 +23,79 @@
 ////////////////////////////////////////////////////////////
 
 
-#include "SPIRIT/Base/Utils/Time/Timer.hpp"
+#ifndef SPIRIT_TIMER_INL_HPP
+#define SPIRIT_TIMER_INL_HPP
+
+#include "Timer.hpp"
 
 
 namespace sp
 {
 
 
-Timer::Timer(bool startNow )
+template <class ClockType>
+BasicTimer<ClockType>::BasicTimer(bool startNow)
 {
-    if ( startNow )
+    if (startNow)
         start();
 }
 
 
+template <class ClockType>
 void
-Timer::reset()
+BasicTimer<ClockType>::reset()
 {
-    time = std::chrono::high_resolution_clock::now();
+    time    = ClockT::now();
     elapsed = std::chrono::nanoseconds{0};
 }
 
 
+template <class ClockType>
 std::chrono::nanoseconds
-Timer::getElapsed() const
+BasicTimer<ClockType>::getElapsed() const
 {
-    if ( paused )
+    if (paused)
         return elapsed;
 
-    return elapsed + std::chrono::high_resolution_clock::now() - time;
+    return elapsed
+           + std::chrono::duration_cast<std::chrono::nanoseconds>(
+               ClockT::now() - time
+           );
 }
 
 
+template <class ClockType>
 double
-Timer::getElapsedNano() const
+BasicTimer<ClockType>::getElapsedNano() const
 {
     return getElapsed().count();
 }
 
 
+template <class ClockType>
 double
-Timer::getElapsedMicro() const
+BasicTimer<ClockType>::getElapsedMicro() const
 {
     return this->getElapsedNano() / 1e3;
 }
 
 
+template <class ClockType>
 double
-Timer::getElapsedMilli() const
+BasicTimer<ClockType>::getElapsedMilli() const
 {
     return this->getElapsedNano() / 1e6;
 }
 
 
+template <class ClockType>
 double
-Timer::getElapsedSec() const
+BasicTimer<ClockType>::getElapsedSec() const
 {
     return this->getElapsedNano() / 1e9;
 }
 
 
 } // namespace sp
+
+#endif // SPIRIT_TIMER_INL_HPP
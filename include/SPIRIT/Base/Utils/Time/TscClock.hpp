@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#ifndef SPIRIT_TSCCLOCK_HPP
+#define SPIRIT_TSCCLOCK_HPP
+
+#include "SPIRIT/Base/Configuration/config.hpp"
+
+#include <chrono>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#    define SPIRIT_HAS_TSC SPIRIT_TRUE
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    else
+#        include <x86intrin.h>
+#    endif
+#else
+#    define SPIRIT_HAS_TSC SPIRIT_FALSE
+#endif
+
+
+namespace sp
+{
+
+namespace details
+{
+
+struct TscCalibration
+{
+    // false when the TSC is missing or not invariant
+    bool usable = false;
+
+    double nsPerTick = 0;
+
+    sp::Uint64 baseTicks = 0;
+    sp::Int64 baseNs     = 0; // steady_clock time at baseTicks
+};
+
+// Measures the TSC frequency against std::chrono::steady_clock
+SPIRIT_API TscCalibration
+calibrateTsc();
+
+inline const TscCalibration &
+tscCalibration()
+{
+    static const TscCalibration calibration = calibrateTsc();
+    return calibration;
+}
+
+} // namespace details
+
+
+//////////////////////////////////////////////////////////
+/// \brief Clock reading the processor's time stamp counter
+///
+/// Reading the TSC takes a few cycles, where the system clocks
+/// go through a (vDSO) call. Use it to time very short scopes.
+///
+/// The TSC frequency is calibrated against std::chrono::steady_clock
+/// once, on first use (about 5ms). Call calibrate() at startup
+/// to avoid paying for it in a measurement.
+///
+/// When the TSC is not invariant (its rate changes with power states)
+/// or unavailable, this falls back to std::chrono::steady_clock.
+/// Both share the same epoch.
+///
+/// Satisfies the standard Clock requirements, usable with BasicTimer.
+///
+//////////////////////////////////////////////////////////
+class TscClock
+{
+public:
+
+    typedef std::chrono::nanoseconds duration;
+    typedef duration::rep rep;
+    typedef duration::period period;
+    typedef std::chrono::time_point<TscClock> time_point;
+
+    static constexpr bool is_steady = true;
+
+    static time_point
+    now() noexcept
+    {
+#if SPIRIT_HAS_TSC
+        const details::TscCalibration & calibration = details::tscCalibration();
+        if (calibration.usable)
+        {
+            sp::Int64 ticks
+                = static_cast<sp::Int64>(__rdtsc() - calibration.baseTicks);
+
+            return time_point{duration{
+                calibration.baseNs
+                + static_cast<rep>(static_cast<double>(ticks) * calibration.nsPerTick)}};
+        }
+#endif
+
+        return time_point{std::chrono::duration_cast<duration>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        )};
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Calibrates now instead of on first use
+    //////////////////////////////////////////////////////////
+    static void
+    calibrate()
+    {
+        details::tscCalibration();
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief true if the TSC is read, false if steady_clock is used
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] static bool
+    usesTsc()
+    {
+        return details::tscCalibration().usable;
+    }
+
+    //////////////////////////////////////////////////////////
+    /// \brief Calibrated TSC frequency, 0 if it is not used
+    //////////////////////////////////////////////////////////
+    [[nodiscard]] static double
+    ticksPerNanosecond()
+    {
+        const details::TscCalibration & calibration = details::tscCalibration();
+        return calibration.usable ? 1 / calibration.nsPerTick : 0;
+    }
+};
+
+} // namespace sp
+
+
+#endif // SPIRIT_TSCCLOCK_HPP
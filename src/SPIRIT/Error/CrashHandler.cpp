@@ -0,0 +1,395 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Error/CrashHandler.hpp"
+#include "SPIRIT/Base/Logging/Logger.hpp"
+
+#include "boost/stacktrace/safe_dump_to.hpp"
+
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#if defined(SPIRIT_OS_WINDOWS)
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+
+namespace sp
+{
+
+namespace
+{
+
+////////////////////////////////////////////////////////////
+// Registered buffers
+////////////////////////////////////////////////////////////
+
+constexpr std::size_t maxCrashBuffers = 32;
+
+// Modified under registryMutex, read without locking by the handler.
+// A slot's fd is always set before its buffer.
+std::mutex registryMutex{};
+std::array<std::atomic<sp::details::OutFileBuf *>, maxCrashBuffers> buffers{};
+std::array<std::atomic<int>, maxCrashBuffers> fds{};
+
+
+////////////////////////////////////////////////////////////
+// Async-signal-safe output
+////////////////////////////////////////////////////////////
+
+#if defined(SPIRIT_OS_WINDOWS)
+constexpr int stderrFd = 2;
+#else
+constexpr int stderrFd = STDERR_FILENO;
+#endif
+
+int
+fileDescriptor(FILE * file)
+{
+#if defined(SPIRIT_OS_WINDOWS)
+    return _fileno(file);
+#else
+    return fileno(file);
+#endif
+}
+
+void
+writeRaw(int fd, const char * str, std::size_t n)
+{
+    while (n > 0)
+    {
+#if defined(SPIRIT_OS_WINDOWS)
+        int wrote = _write(fd, str, static_cast<unsigned int>(n));
+#else
+        ssize_t wrote = ::write(fd, str, n);
+#endif
+        if (wrote <= 0)
+            return;
+
+        str += wrote;
+        n -= static_cast<std::size_t>(wrote);
+    }
+}
+
+void
+writeRaw(int fd, const char * str)
+{
+    std::size_t n = 0;
+    while (str[n] != '\0') ++n;
+
+    writeRaw(fd, str, n);
+}
+
+void
+writeNumber(int fd, std::uintptr_t value, unsigned base, std::size_t minDigits = 1)
+{
+    constexpr char digits[] = "0123456789abcdef";
+
+    char buf[3 * sizeof(std::uintptr_t)];
+    std::size_t pos = sizeof(buf);
+    do
+    {
+        buf[--pos] = digits[value % base];
+        value /= base;
+    } while (value != 0 || sizeof(buf) - pos < minDigits);
+
+    writeRaw(fd, buf + pos, sizeof(buf) - pos);
+}
+
+const char *
+signalName(int sig)
+{
+    switch (sig)
+    {
+    case SIGSEGV: return "SIGSEGV";
+    case SIGABRT: return "SIGABRT";
+    case SIGFPE: return "SIGFPE";
+#if !defined(SPIRIT_OS_WINDOWS)
+    case SIGBUS: return "SIGBUS";
+#endif
+    default: return "unknown signal";
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+// Handling
+////////////////////////////////////////////////////////////
+
+constexpr std::size_t maxCrashFrames = 64;
+
+void
+dumpStacktrace()
+{
+    void * frames[maxCrashFrames];
+    std::size_t nFrames
+        = boost::stacktrace::safe_dump_to(frames, sizeof(frames));
+
+    writeRaw(stderrFd, "Stacktrace (raw addresses):\n");
+    // the dump may be terminated by a null frame
+    for (std::size_t i = 0; i < nFrames && frames[i] != nullptr; ++i)
+    {
+        writeRaw(stderrFd, i < 10 ? " " : "");
+        writeNumber(stderrFd, i, 10);
+        writeRaw(stderrFd, "# 0x");
+        writeNumber(
+            stderrFd,
+            reinterpret_cast<std::uintptr_t>(frames[i]),
+            16,
+            2 * sizeof(void *)
+        );
+        writeRaw(stderrFd, "\n");
+    }
+}
+
+void
+flushBuffers()
+{
+    for (std::size_t i = 0; i < maxCrashBuffers; ++i)
+    {
+        sp::details::OutFileBuf * buf = buffers[i].load();
+        if (buf == nullptr)
+            continue;
+
+#if !defined(SPIRIT_OS_WINDOWS)
+        // Not async-signal-safe, skipped when the FILE is in use
+        // since the crashing thread may never release it.
+        FILE * file = buf->file();
+        if (ftrylockfile(file) == 0)
+        {
+            fflush(file);
+            funlockfile(file);
+        }
+#endif
+
+        std::string_view pending = buf->pendingOutput();
+        writeRaw(fds[i].load(), pending.data(), pending.size());
+    }
+}
+
+
+#if defined(SPIRIT_OS_WINDOWS)
+constexpr std::array<int, 3> crashSignals{SIGSEGV, SIGABRT, SIGFPE};
+typedef void (*SignalHandler)(int);
+std::array<SignalHandler, crashSignals.size()> previousHandlers{};
+#else
+constexpr std::array<int, 4> crashSignals{SIGSEGV, SIGABRT, SIGBUS, SIGFPE};
+std::array<struct sigaction, crashSignals.size()> previousHandlers{};
+
+// large enough to run the handler after a stack overflow
+constexpr std::size_t alternateStackSize = 64 * 1024;
+
+// The thread's alternate stack, the previous one is restored when the
+// thread exits
+struct AlternateStack
+{
+    std::unique_ptr<char[]> memory{};
+    stack_t previous{};
+
+    ~AlternateStack()
+    {
+        stack_t current{};
+        if (memory && sigaltstack(nullptr, &current) == 0 && current.ss_sp == memory.get())
+            sigaltstack(&previous, nullptr);
+    }
+};
+
+thread_local AlternateStack alternateStack{};
+#endif
+
+std::mutex installMutex{};
+bool installed = false;
+
+std::atomic<bool> crashing{false};
+
+
+// must be locked
+void
+restoreHandlers()
+{
+    for (std::size_t i = 0; i < crashSignals.size(); ++i)
+    {
+#if defined(SPIRIT_OS_WINDOWS)
+        std::signal(crashSignals[i], previousHandlers[i]);
+#else
+        sigaction(crashSignals[i], &previousHandlers[i], nullptr);
+#endif
+    }
+}
+
+void
+restoreHandler(int sig)
+{
+    for (std::size_t i = 0; i < crashSignals.size(); ++i)
+    {
+        if (crashSignals[i] != sig)
+            continue;
+
+#if defined(SPIRIT_OS_WINDOWS)
+        std::signal(sig, previousHandlers[i]);
+#else
+        sigaction(sig, &previousHandlers[i], nullptr);
+#endif
+    }
+}
+
+void
+crashHandler(int sig)
+{
+    // a crash while handling a crash, give up
+    if (crashing.exchange(true))
+    {
+        std::signal(sig, SIG_DFL);
+        std::raise(sig);
+        return;
+    }
+
+    writeRaw(stderrFd, "\nSpirit: received fatal signal ");
+    writeRaw(stderrFd, signalName(sig));
+    writeRaw(stderrFd, "\n");
+
+    dumpStacktrace();
+    flushBuffers();
+
+    restoreHandler(sig);
+    std::raise(sig);
+}
+
+} // namespace
+
+
+void
+installCrashHandler()
+{
+    std::lock_guard lock{installMutex};
+    if (installed)
+        return;
+
+    registerCrashFlush(sp::ansiOut);
+    registerCrashFlush(sp::ansiErr);
+    for (const auto & sink : sp::spiritLogger()->sinks())
+    {
+        if (auto * stream = dynamic_cast<sp::AnsiFileStream *>(sink.get()))
+            registerCrashFlush(*stream);
+    }
+
+#if defined(SPIRIT_OS_WINDOWS)
+    for (std::size_t i = 0; i < crashSignals.size(); ++i)
+        previousHandlers[i] = std::signal(crashSignals[i], &crashHandler);
+#else
+    installCrashStack();
+
+    struct sigaction action
+    {
+    };
+    action.sa_handler = &crashHandler;
+    action.sa_flags   = SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+
+    for (std::size_t i = 0; i < crashSignals.size(); ++i)
+        sigaction(crashSignals[i], &action, &previousHandlers[i]);
+#endif
+
+    installed = true;
+}
+
+void
+installCrashStack()
+{
+#if !defined(SPIRIT_OS_WINDOWS)
+    if (alternateStack.memory)
+        return;
+
+    auto memory = std::unique_ptr<char[]>{new char[alternateStackSize]};
+
+    stack_t stack{};
+    stack.ss_sp    = memory.get();
+    stack.ss_size  = alternateStackSize;
+    stack.ss_flags = 0;
+    if (sigaltstack(&stack, &alternateStack.previous) == 0)
+        alternateStack.memory = std::move(memory);
+#endif
+}
+
+void
+uninstallCrashHandler()
+{
+    std::lock_guard lock{installMutex};
+    if (!installed)
+        return;
+
+    restoreHandlers();
+    installed = false;
+}
+
+
+bool
+registerCrashFlush(sp::details::OutFileBuf & buf)
+{
+    std::lock_guard lock{registryMutex};
+
+    for (const auto & registered : buffers)
+        if (registered.load() == &buf)
+            return true;
+
+    for (std::size_t i = 0; i < maxCrashBuffers; ++i)
+    {
+        if (buffers[i].load() != nullptr)
+            continue;
+
+        fds[i].store(fileDescriptor(buf.file()));
+        buffers[i].store(&buf);
+        buf.isCrashFlushed.store(true);
+        return true;
+    }
+
+    return false;
+}
+
+void
+unregisterCrashFlush(sp::details::OutFileBuf & buf)
+{
+    sp::details::forgetCrashFlush(&buf);
+    buf.isCrashFlushed.store(false);
+}
+
+void
+details::forgetCrashFlush(const void * buf) noexcept
+{
+    std::lock_guard lock{registryMutex};
+
+    for (auto & registered : buffers)
+        if (registered.load() == buf)
+            registered.store(nullptr);
+}
+
+} // namespace sp
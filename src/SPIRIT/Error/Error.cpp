@@ -24,10 +24,14 @@
 
 
 #include "SPIRIT/Base/Error/Error.hpp"
+#include "SPIRIT/Base/Error/details/SymbolCache.hpp"
 
 // #include <stacktrace> // in C++23
 #include "boost/stacktrace.hpp"
 
+#include <mutex>
+#include <vector>
+
 
 namespace sp
 {
@@ -35,8 +39,34 @@ namespace sp
 typedef boost::stacktrace::stacktrace Stacktrace;
 typedef boost::stacktrace::frame Frame;
 
+namespace details
+{
+
+struct ErrorData
+{
+    // raw return addresses, resolved lazily
+    std::vector<const void *> frames{};
+    std::string message{};
+
+    std::once_flag built{};
+    std::string explanation{};
+};
+
+} // namespace details
+
+// Deeper frames are dropped
+constexpr std::size_t maxStacktraceDepth = 128;
+
 std::string
-stringifyStacktrace(const Stacktrace & st)
+resolveFrame(const void * address)
+{
+    return boost::stacktrace::to_string(Frame{address});
+}
+
+// Same layout as boost::stacktrace::to_string(stacktrace), with frames
+// resolved through the symbol cache
+std::string
+stringifyStacktrace(const std::vector<const void *> & frames)
 {
     ///////////////////////////////////////////////////////
     // Some implementations will always return empty strings here...
@@ -48,13 +78,77 @@ stringifyStacktrace(const Stacktrace & st)
     //     std::cout << bt.source_line();
     // }
 
-    return boost::stacktrace::to_string(st);
+    details::SymbolCache & cache = details::SymbolCache::global();
+
+    std::string str{};
+    for (std::size_t i = 0; i < frames.size(); ++i)
+    {
+        if (i < 10)
+            str += ' ';
+
+        str += std::to_string(i) + "# " + cache.get(frames[i], &resolveFrame) + '\n';
+    }
+
+    return str;
+}
+
+SpiritError::SpiritError() : data{std::make_shared<details::ErrorData>()}
+{
+#if SPIRIT_USE_STACKTRACE
+    // Only walks the stack, symbols are resolved in what()
+    const void * frames[maxStacktraceDepth];
+    std::size_t nFrames
+        = boost::stacktrace::safe_dump_to(1, frames, sizeof(frames));
+
+    data->frames.assign(frames, frames + nFrames);
+#endif
+}
+
+const char *
+SpiritError::what() const noexcept
+{
+    details::ErrorData & d = *data;
+
+    try
+    {
+        std::call_once(
+            d.built,
+            [&d]()
+            {
+                std::string explanation{};
+
+                if (!d.frames.empty())
+                {
+                    explanation
+                        += "Stacktrace:\n" + stringifyStacktrace(d.frames) + "\n";
+                }
+
+                if (!d.message.empty())
+                    explanation += "Error message: \n" + d.message + "\n";
+
+                d.explanation = std::move(explanation);
+            }
+        );
+    }
+    catch (...)
+    {
+        // could not build it, the message is better than nothing
+        return d.message.c_str();
+    }
+
+    return d.explanation.c_str();
+}
+
+std::string_view
+SpiritError::message() const noexcept
+{
+    return data->message;
 }
 
-SpiritError::SpiritError()
-    : explanation{
-        std::string{"Stacktrace:\n"} + stringifyStacktrace(Stacktrace{}) + "\n"}
+void
+SpiritError::setMessage(std::string && msg)
 {
+    data->message = std::move(msg);
 }
 
 
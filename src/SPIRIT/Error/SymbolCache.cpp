@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Error/details/SymbolCache.hpp"
+
+namespace sp
+{
+namespace details
+{
+
+SymbolCache &
+SymbolCache::global()
+{
+    static SymbolCache cache{};
+    return cache;
+}
+
+std::string
+SymbolCache::get(const void * address, Resolver resolve)
+{
+    {
+        std::lock_guard lock{mutex};
+
+        auto it = index.find(address);
+        if (it != index.end())
+        {
+            entries.splice(entries.begin(), entries, it->second);
+            return it->second->second;
+        }
+    }
+
+    std::string symbol = resolve(address);
+
+    std::lock_guard lock{mutex};
+    if (maxEntries == 0 || index.find(address) != index.end())
+        return symbol;
+
+    evict(maxEntries - 1);
+    entries.emplace_front(address, symbol);
+    index.emplace(address, entries.begin());
+
+    return symbol;
+}
+
+void
+SymbolCache::setCapacity(std::size_t capacity)
+{
+    std::lock_guard lock{mutex};
+    maxEntries = capacity;
+    evict(maxEntries);
+}
+
+std::size_t
+SymbolCache::capacity() const
+{
+    std::lock_guard lock{mutex};
+    return maxEntries;
+}
+
+std::size_t
+SymbolCache::size() const
+{
+    std::lock_guard lock{mutex};
+    return entries.size();
+}
+
+void
+SymbolCache::clear()
+{
+    std::lock_guard lock{mutex};
+    entries.clear();
+    index.clear();
+}
+
+void
+SymbolCache::evict(std::size_t maxSize)
+{
+    while (entries.size() > maxSize)
+    {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+} // namespace details
+} // namespace sp
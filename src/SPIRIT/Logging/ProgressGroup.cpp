@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Logging/ProgressGroup.hpp"
+
+#include "spdlog/sinks/dist_sink.h"
+
+#include <algorithm>
+
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+// Forwards records to the logger's original sinks, the bars are erased
+// while they are written and redrawn below them.
+//
+// Installed once per logger and never removed: spdlog does not
+// synchronize its sinks vector with logging threads. Detaching unbinds
+// the group under the sink's mutex instead, records then pass through.
+////////////////////////////////////////////////////////////
+class ProgressGroup::LogSink : public spdlog::sinks::dist_sink<std::mutex>
+{
+    typedef spdlog::sinks::dist_sink<std::mutex> Base;
+
+public:
+
+    explicit LogSink(std::vector<spdlog::sink_ptr> sinks) : Base{std::move(sinks)}
+    {
+    }
+
+    // Records are sunk with mutex_ held, then lock the group's mutex.
+    // The group's mutex must therefore not be held while binding.
+    void
+    bind(ProgressGroup * newGroup)
+    {
+        std::lock_guard<std::mutex> lock{this->mutex_};
+        group = newGroup;
+    }
+
+    // Unbinds only if still bound to oldGroup
+    void
+    release(ProgressGroup & oldGroup)
+    {
+        std::lock_guard<std::mutex> lock{this->mutex_};
+        if (group == &oldGroup)
+            group = nullptr;
+    }
+
+    static std::shared_ptr<LogSink>
+    find(const sp::LoggerPtr & logger)
+    {
+        for (const auto & sink : logger->sinks())
+            if (auto logSink = std::dynamic_pointer_cast<LogSink>(sink))
+                return logSink;
+
+        return nullptr;
+    }
+
+protected:
+
+    void
+    sink_it_(const spdlog::details::log_msg & msg) override
+    {
+        if (group == nullptr)
+        {
+            Base::sink_it_(msg);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock{group->mutex};
+
+        bool showsBars = group->running.load(std::memory_order_relaxed)
+                         && group->out.isAnsiEnabled();
+        if (showsBars)
+            group->screen.erase();
+
+        Base::sink_it_(msg);
+
+        if (showsBars)
+        {
+            // The record must be out before the bars are drawn below it
+            Base::flush_();
+            group->draw();
+        }
+    }
+
+private:
+
+    ProgressGroup * group = nullptr;
+};
+
+
+ProgressGroup::ProgressGroup(
+    sp::AnsiFileStream & out,
+    sp::Clock::Nanoseconds refreshPeriod,
+    sp::Int32 barWidth
+)
+    : out{out}, barWidth{std::max(barWidth, 1)}, screen{out, 0, 0, 0},
+      clock{refreshPeriod}, renderer{&ProgressGroup::renderLoop, this}
+{
+}
+
+
+ProgressGroup::~ProgressGroup()
+{
+    stop();
+
+    // without holding mutex, see LogSink::bind
+    std::vector<std::shared_ptr<LogSink>> sinks{};
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        sinks.swap(attached);
+    }
+
+    for (auto & sink : sinks) sink->release(*this);
+}
+
+
+ProgressBar
+ProgressGroup::addBar(std::string label, sp::Uint64 total)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    details::ProgressCounter & counter = counters.emplace_back();
+    counter.total = total;
+    counter.label = std::move(label);
+
+    sp::Uint64 maxTotal = 0;
+    labelWidth          = 0;
+    for (const auto & c : counters)
+    {
+        maxTotal   = std::max(maxTotal, c.total);
+        labelWidth = std::max(labelWidth, static_cast<sp::Int32>(c.label.size()));
+    }
+
+    // "label [bar] 100% value/total"
+    sp::Int32 totalWidth = static_cast<sp::Int32>(sp::format(maxTotal).size());
+    sp::Int32 columns    = labelWidth + 2 + barWidth + 7 + 2 * totalWidth + 1;
+
+    screen.resize(static_cast<sp::Int32>(counters.size()), columns);
+    return ProgressBar{&counter};
+}
+
+
+void
+ProgressGroup::attach(const sp::LoggerPtr & logger)
+{
+    std::shared_ptr<LogSink> sink = LogSink::find(logger);
+    if (sink == nullptr)
+    {
+        sink = std::make_shared<LogSink>(logger->sinks());
+        logger->sinks() = {sink};
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (std::find(attached.begin(), attached.end(), sink) != attached.end())
+            return;
+
+        attached.push_back(sink);
+    }
+
+    sink->bind(this);
+}
+
+
+void
+ProgressGroup::detach(const sp::LoggerPtr & logger)
+{
+    std::shared_ptr<LogSink> sink = LogSink::find(logger);
+    if (sink == nullptr)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto it = std::find(attached.begin(), attached.end(), sink);
+        if (it == attached.end())
+            return;
+
+        attached.erase(it);
+    }
+
+    sink->release(*this);
+}
+
+
+void
+ProgressGroup::stop()
+{
+    if (!renderer.joinable())
+        return;
+
+    running.store(false, std::memory_order_relaxed);
+    renderer.join();
+
+    std::lock_guard<std::mutex> lock{mutex};
+    if (!counters.empty())
+    {
+        draw();
+        out << "\n" << std::flush;
+    }
+}
+
+
+void
+ProgressGroup::renderLoop()
+{
+    while (running.load(std::memory_order_relaxed))
+    {
+        clock.tick(); // waits for the refresh period
+
+        std::lock_guard<std::mutex> lock{mutex};
+        if (out.isAnsiEnabled())
+            draw();
+    }
+}
+
+
+void
+ProgressGroup::draw()
+{
+    if (counters.empty())
+        return;
+
+    screen.clear();
+    for (std::size_t row = 0; row < counters.size(); ++row)
+        drawBar(static_cast<sp::Int32>(row), counters[row]);
+
+    screen.presentNow();
+}
+
+
+void
+ProgressGroup::drawBar(sp::Int32 row, const details::ProgressCounter & counter)
+{
+    sp::Uint64 total = counter.total;
+    sp::Uint64 value = std::min(counter.value.load(std::memory_order_relaxed), total);
+
+    double done = total == 0 ? 1.0 : static_cast<double>(value) / total;
+    sp::Int32 filled = static_cast<sp::Int32>(done * barWidth);
+
+    screen.print(row, 0, counter.label);
+
+    sp::Int32 column = labelWidth;
+    column += screen.print(row, column, " [");
+    for (sp::Int32 i = 0; i < barWidth; ++i)
+    {
+        if (i < filled)
+            screen.put(row, column + i, sp::ScreenCell{'#', sp::green});
+        else
+            screen.put(row, column + i, sp::ScreenCell{'-'});
+    }
+    column += barWidth;
+
+    screen.print(
+        row,
+        column,
+        sp::format("] {:>3}% {}/{}", static_cast<sp::Int32>(done * 100), value, total)
+    );
+}
+
+} // namespace sp
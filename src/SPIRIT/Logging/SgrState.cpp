@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Logging/details/SgrState.hpp"
+
+#include <initializer_list>
+
+
+namespace sp
+{
+namespace details
+{
+
+bool
+SgrState::apply(const sp::Int32 * params, sp::Int32 nParams)
+{
+    SgrState before = *this;
+
+    if (nParams == 0)
+        applyCode(0);
+
+    for (sp::Int32 i = 0; i < nParams; ++i)
+    {
+        sp::Int32 code = params[i];
+        if (code == 38 || code == 48)
+        {
+            sp::Uint32 & color = code == 38 ? fg : bg;
+            sp::Int32 consumed
+                = readExtendedColor(params + i + 1, nParams - i - 1, color);
+
+            if (consumed < 0)
+            {
+                // Can't tell how the terminal will read the rest
+                known = false;
+                break;
+            }
+
+            i += consumed;
+        }
+        else
+            applyCode(code);
+    }
+
+    return !before.known || !known || before != *this;
+}
+
+
+sp::Int32
+SgrState::readExtendedColor(
+    const sp::Int32 * params,
+    sp::Int32 nParams,
+    sp::Uint32 & color
+)
+{
+    if (nParams >= 2 && params[0] == 5)
+    {
+        color = packColor(paletteColor, static_cast<sp::Uint32>(params[1]));
+        return 2;
+    }
+
+    if (nParams >= 4 && params[0] == 2)
+    {
+        sp::Uint32 rgb = (static_cast<sp::Uint32>(params[1] & 0xFF) << 16)
+                         | (static_cast<sp::Uint32>(params[2] & 0xFF) << 8)
+                         | static_cast<sp::Uint32>(params[3] & 0xFF);
+        color = packColor(rgbColor, rgb);
+        return 4;
+    }
+
+    return -1;
+}
+
+
+void
+SgrState::applyCode(sp::Int32 code)
+{
+    auto clear = [this](std::initializer_list<sp::Int32> mods)
+    {
+        for (sp::Int32 mod : mods) modifiers &= ~(1u << mod);
+    };
+
+    if (code == 0)
+        *this = SgrState{};
+
+    else if ((1 <= code && code <= 9) || code == 21)
+        modifiers |= 1u << code;
+
+    else if (10 <= code && code <= 20)
+        font = static_cast<sp::Uint8>(code - 10);
+
+    else if (code == 22)
+        clear({1, 2});
+    else if (code == 23)
+        clear({3});
+    else if (code == 24)
+        clear({4, 21});
+    else if (code == 25)
+        clear({5, 6});
+    else if (code == 27)
+        clear({7});
+    else if (code == 28)
+        clear({8});
+    else if (code == 29)
+        clear({9});
+
+    else if ((30 <= code && code <= 37) || (90 <= code && code <= 97))
+        fg = packColor(basicColor, static_cast<sp::Uint32>(code));
+    else if (code == 39)
+        fg = defaultColor;
+
+    else if ((40 <= code && code <= 47) || (100 <= code && code <= 107))
+        bg = packColor(basicColor, static_cast<sp::Uint32>(code));
+    else if (code == 49)
+        bg = defaultColor;
+
+    else
+        known = false;
+}
+
+
+} // namespace details
+} // namespace sp
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Logging/StatsReporter.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+// Counter
+////////////////////////////////////////////////////////////
+
+Counter::Counter(std::size_t nShards)
+    : nShards{nShards != 0 ? nShards : std::max(1u, std::thread::hardware_concurrency())},
+      shards{std::make_unique<Shard[]>(this->nShards)}
+{
+}
+
+sp::Uint64
+Counter::read() const
+{
+    sp::Uint64 total = 0;
+    for (std::size_t i = 0; i < nShards; ++i)
+        total += shards[i].value.load(std::memory_order_relaxed);
+
+    return total;
+}
+
+
+////////////////////////////////////////////////////////////
+// StatsReporter
+////////////////////////////////////////////////////////////
+
+StatsReporter::StatsReporter(
+    sp::LoggerPtr logger,
+    sp::Clock::Nanoseconds period,
+    sp::LogLevel level
+)
+    : logger{std::move(logger)}, level{level}, period{period},
+      reporter{&StatsReporter::reportLoop, this}
+{
+}
+
+StatsReporter::~StatsReporter()
+{
+    stop();
+}
+
+void
+StatsReporter::addCounter(std::string name, const Counter & counter)
+{
+    addCounter(std::move(name), [&counter]() { return counter.read(); });
+}
+
+void
+StatsReporter::addCounter(std::string name, CounterCallback total)
+{
+    std::lock_guard lock{mutex};
+
+    sp::Uint64 current = total();
+    stats.push_back(Stat{std::move(name), CounterStat{std::move(total), current}});
+}
+
+void
+StatsReporter::addGauge(std::string name, GaugeCallback gauge)
+{
+    std::lock_guard lock{mutex};
+    stats.push_back(Stat{std::move(name), GaugeStat{std::move(gauge)}});
+}
+
+void
+StatsReporter::addHistogram(std::string name, Histogram & histogram)
+{
+    std::lock_guard lock{mutex};
+
+    histogram.reset();
+    stats.push_back(Stat{std::move(name), HistogramStat{&histogram}});
+}
+
+void
+StatsReporter::remove(std::string_view name)
+{
+    std::lock_guard lock{mutex};
+    std::erase_if(stats, [name](const Stat & stat) { return stat.name == name; });
+}
+
+std::string
+StatsReporter::collect()
+{
+    std::lock_guard lock{mutex};
+
+    sp::Clock::Nanoseconds elapsed = clock.tick();
+    double seconds = std::chrono::duration<double>(elapsed).count();
+
+    std::string record = sp::format("Stats over {}:", formatDuration(elapsed));
+
+    for (Stat & stat : stats)
+    {
+        record += &stat == &stats.front() ? " " : ", ";
+        record += stat.name;
+
+        if (auto * counter = std::get_if<CounterStat>(&stat.stat))
+        {
+            sp::Uint64 total = counter->total();
+            sp::Uint64 delta = total - counter->last;
+            counter->last    = total;
+
+            record += sp::format(
+                " {} ({:.2f}/s)",
+                delta,
+                seconds > 0 ? static_cast<double>(delta) / seconds : 0.0
+            );
+        }
+        else if (auto * gauge = std::get_if<GaugeStat>(&stat.stat))
+        {
+            record += sp::format(" {:g}", gauge->value());
+        }
+        else if (auto * histogram = std::get_if<HistogramStat>(&stat.stat))
+        {
+            HistogramSnapshot snapshot = histogram->histogram->snapshot(true);
+
+            record += sp::format(
+                " n={} p50 {} p99 {} max {}",
+                snapshot.count(),
+                formatDuration(snapshot.p50()),
+                formatDuration(snapshot.p99()),
+                formatDuration(snapshot.max())
+            );
+        }
+    }
+
+    return record;
+}
+
+void
+StatsReporter::reportNow()
+{
+    std::string record = collect();
+    logger->log(level, record);
+}
+
+void
+StatsReporter::stop()
+{
+    if (!reporter.joinable())
+        return;
+
+    {
+        std::lock_guard lock{stopMutex};
+        running = false;
+    }
+
+    stopped.notify_all();
+    reporter.join();
+}
+
+sp::Clock::Nanoseconds
+StatsReporter::sinceRecord()
+{
+    std::lock_guard lock{mutex};
+    return clock.getCurrentDt();
+}
+
+void
+StatsReporter::reportLoop()
+{
+    std::unique_lock lock{stopMutex};
+
+    while (true)
+    {
+        // the clock is ticked by each record, wait for the rest of the period
+        if (stopped.wait_for(lock, period - sinceRecord(), [this]() { return !running; }))
+            return;
+
+        if (sinceRecord() >= period)
+        {
+            lock.unlock();
+            reportNow();
+            lock.lock();
+        }
+    }
+}
+
+} // namespace sp
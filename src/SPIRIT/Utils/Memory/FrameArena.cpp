@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Utils/Memory/FrameArena.hpp"
+
+#include "SPIRIT/Base/Error/Error.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace sp
+{
+
+namespace
+{
+
+constexpr std::size_t bufferAlign = 64;
+
+std::byte *
+allocateBuffer(std::size_t size)
+{
+    return static_cast<std::byte *>(
+        ::operator new(size, std::align_val_t{bufferAlign})
+    );
+}
+
+void
+deallocateBuffer(std::byte * buffer) noexcept
+{
+    ::operator delete(buffer, std::align_val_t{bufferAlign});
+}
+
+// Aligns cursor up, nullptr if size bytes don't fit before end
+std::byte *
+bump(std::byte *& cursor, std::byte * end, std::size_t size, std::size_t alignment)
+{
+    auto address  = reinterpret_cast<std::uintptr_t>(cursor);
+    auto aligned  = (address + alignment - 1) & ~(alignment - 1);
+    auto limit    = reinterpret_cast<std::uintptr_t>(end);
+
+    if (aligned < address || aligned > limit || limit - aligned < size)
+        return nullptr;
+
+    auto * allocation = cursor + (aligned - address);
+    cursor            = allocation + size;
+    return allocation;
+}
+
+} // namespace
+
+
+void *
+details::FrameArenaResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    return arena.allocate(bytes, alignment);
+}
+
+
+struct FrameArena::Block
+{
+    Block * next;
+    std::size_t size; // total, header included
+};
+
+
+FrameArena::FrameArena(std::size_t frameCapacity)
+{
+    frameCapacity = std::max<std::size_t>(frameCapacity, bufferAlign);
+
+    for (Buffer & buffer : buffers)
+    {
+        buffer.data     = allocateBuffer(frameCapacity);
+        buffer.capacity = frameCapacity;
+    }
+
+    cursor = buffers[current].data;
+    end    = cursor + frameCapacity;
+}
+
+
+FrameArena::~FrameArena()
+{
+    for (Buffer & buffer : buffers)
+    {
+        freeOverflow(buffer);
+        deallocateBuffer(buffer.data);
+    }
+}
+
+
+void *
+FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+    SPIRIT_ASSERT(
+        std::has_single_bit(alignment),
+        "Alignment {} is not a power of two",
+        alignment
+    );
+
+    std::byte * start  = cursor;
+    void * allocation  = bump(cursor, end, size, alignment);
+    if (allocation != nullptr) [[likely]]
+        frameUsage += static_cast<std::size_t>(cursor - start);
+    else
+        allocation = this->allocateOverflow(size, alignment);
+
+    highWaterMark = std::max(highWaterMark, frameUsage);
+    return allocation;
+}
+
+
+void *
+FrameArena::allocateOverflow(std::size_t size, std::size_t alignment)
+{
+    // At least as big as the buffer, the frame likely keeps allocating
+    std::size_t header    = (sizeof(Block) + bufferAlign - 1) & ~(bufferAlign - 1);
+    std::size_t blockSize = header + std::max(size + alignment, buffers[current].capacity);
+    if (blockSize < size)
+        throw std::bad_alloc{};
+
+    auto * block = ::new (allocateBuffer(blockSize)) Block{
+        buffers[current].overflow,
+        blockSize
+    };
+    buffers[current].overflow = block;
+    ++overflowCount;
+
+    cursor = reinterpret_cast<std::byte *>(block) + header;
+    end    = reinterpret_cast<std::byte *>(block) + blockSize;
+
+    std::byte * start = cursor;
+    void * allocation = bump(cursor, end, size, alignment);
+    frameUsage += static_cast<std::size_t>(cursor - start);
+
+    return allocation;
+}
+
+
+void
+FrameArena::nextFrame()
+{
+    // Stays in the current frame if growing throws
+    freeOverflow(buffers[1 - current]);
+    grow(buffers[1 - current]);
+    current = 1 - current;
+
+    cursor     = buffers[current].data;
+    end        = cursor + buffers[current].capacity;
+    frameUsage = 0;
+    ++frameCount;
+}
+
+
+void
+FrameArena::freeOverflow(Buffer & buffer) noexcept
+{
+    while (buffer.overflow != nullptr)
+    {
+        Block * block   = buffer.overflow;
+        buffer.overflow = block->next;
+        deallocateBuffer(reinterpret_cast<std::byte *>(block));
+    }
+}
+
+
+void
+FrameArena::grow(Buffer & buffer)
+{
+    // Padding differs from frame to frame, keep some slack
+    if (highWaterMark > buffer.capacity)
+    {
+        std::size_t capacity = std::bit_ceil(highWaterMark + highWaterMark / 8);
+        std::byte * data     = allocateBuffer(capacity);
+
+        deallocateBuffer(buffer.data);
+        buffer.data     = data;
+        buffer.capacity = capacity;
+    }
+}
+
+
+} // namespace sp
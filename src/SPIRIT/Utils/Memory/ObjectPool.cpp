@@ -0,0 +1,436 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#include "SPIRIT/Base/Utils/Memory/ObjectPool.hpp"
+
+#include "SPIRIT/Base/Error/Error.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+// Free slots
+////////////////////////////////////////////////////////////
+
+namespace details
+{
+
+struct FreeSlot
+{
+    FreeSlot * next = nullptr;
+
+    // On the top slot of a batch in the shared stack: the next batch
+    // and, in the high bits, this batch's slot count
+    std::atomic<sp::Uint64> nextBatch{0};
+};
+
+} // namespace details
+
+
+namespace
+{
+
+// Pointers are packed with a tag or a count in the bits that
+// user space addresses leave unused
+constexpr unsigned pointerBits = sizeof(void *) == 8 ? 48 : 32;
+constexpr sp::Uint64 pointerMask = (sp::Uint64{1} << pointerBits) - 1;
+
+template <class T>
+T *
+pointerOf(sp::Uint64 packed)
+{
+    return reinterpret_cast<T *>(static_cast<std::uintptr_t>(packed & pointerMask));
+}
+
+sp::Uint64
+highOf(sp::Uint64 packed)
+{
+    return packed >> pointerBits;
+}
+
+sp::Uint64
+pack(const void * ptr, sp::Uint64 high)
+{
+    return (high << pointerBits) | reinterpret_cast<std::uintptr_t>(ptr);
+}
+
+std::size_t
+roundUp(std::size_t size, std::size_t align)
+{
+    return (size + align - 1) / align * align;
+}
+
+constexpr std::size_t minSlabSize = 64 * 1024;
+
+////////////////////////////////////////////////////////////
+// Live pools, thread caches must not touch destroyed pools
+////////////////////////////////////////////////////////////
+
+std::atomic<sp::Uint64> nextPoolId{1};
+
+std::mutex &
+livePoolsMutex()
+{
+    // Leaked, threads may exit after static destruction
+    static auto * mutex = new std::mutex{};
+    return *mutex;
+}
+
+std::unordered_set<sp::Uint64> &
+livePools()
+{
+    static auto * pools = new std::unordered_set<sp::Uint64>{};
+    return *pools;
+}
+
+} // namespace
+
+
+////////////////////////////////////////////////////////////
+// Thread caches
+////////////////////////////////////////////////////////////
+
+namespace details
+{
+
+struct SlabPoolCache
+{
+    sp::Uint64 poolId;
+    SlabPool * pool;
+
+    FreeSlot * head  = nullptr;
+    sp::Uint32 count = 0;
+};
+
+struct SlabPoolCaches
+{
+    std::vector<SlabPoolCache> caches{};
+    std::size_t lastUsed = 0;
+
+    SlabPoolCache &
+    find(SlabPool & pool)
+    {
+        for (std::size_t i = 0; i < caches.size(); ++i)
+        {
+            if (caches[i].poolId == pool.id)
+            {
+                lastUsed = i;
+                return caches[i];
+            }
+        }
+
+        // First use of this pool by this thread, forget destroyed pools
+        {
+            std::lock_guard lock{livePoolsMutex()};
+            std::erase_if(
+                caches,
+                [](const SlabPoolCache & cache)
+                { return !livePools().contains(cache.poolId); }
+            );
+        }
+
+        caches.push_back(SlabPoolCache{pool.id, &pool});
+        lastUsed = caches.size() - 1;
+        return caches.back();
+    }
+
+    ~SlabPoolCaches()
+    {
+        // Other threads may reuse our slots, unless their pool is gone
+        std::lock_guard lock{livePoolsMutex()};
+        for (SlabPoolCache & cache : caches)
+        {
+            if (cache.count != 0 && livePools().contains(cache.poolId))
+                cache.pool->pushBatch(cache.head, cache.count);
+        }
+    }
+};
+
+} // namespace details
+
+namespace
+{
+
+// Plain pointer, remains usable in other thread_local destructors
+thread_local details::SlabPoolCaches * threadCaches = nullptr;
+thread_local bool threadCachesDestroyed            = false;
+
+struct ThreadCachesOwner
+{
+    ~ThreadCachesOwner()
+    {
+        delete threadCaches;
+        threadCaches          = nullptr;
+        threadCachesDestroyed = true;
+    }
+};
+
+thread_local ThreadCachesOwner threadCachesOwner{};
+
+} // namespace
+
+details::SlabPoolCache *
+SlabPool::localCache()
+{
+    details::SlabPoolCaches * caches = threadCaches;
+    if (caches != nullptr) [[likely]]
+    {
+        details::SlabPoolCache & last = caches->caches[caches->lastUsed];
+        if (last.poolId == id) [[likely]]
+            return &last;
+
+        return &caches->find(*this);
+    }
+
+    if (threadCachesDestroyed)
+        return nullptr;
+
+    static_cast<void>(&threadCachesOwner); // constructs the owner
+    threadCaches = new details::SlabPoolCaches{};
+    return &threadCaches->find(*this);
+}
+
+
+////////////////////////////////////////////////////////////
+// SlabPool
+////////////////////////////////////////////////////////////
+
+SlabPool::SlabPool(std::size_t size, std::size_t align)
+    : id{nextPoolId.fetch_add(1, std::memory_order_relaxed)},
+      slotSize{roundUp(
+          std::max(size, sizeof(FreeSlot)),
+          std::max(align, alignof(FreeSlot))
+      )},
+      slotAlign{std::max(align, alignof(FreeSlot))},
+      slabSize{std::max(minSlabSize, slotSize * batchSize)}
+{
+    std::lock_guard lock{livePoolsMutex()};
+    livePools().insert(id);
+}
+
+SlabPool::~SlabPool()
+{
+    {
+        std::lock_guard lock{livePoolsMutex()};
+        livePools().erase(id);
+    }
+
+    for (void * slab : slabs)
+        ::operator delete(slab, std::align_val_t{slotAlign});
+}
+
+void *
+SlabPool::allocate()
+{
+    details::SlabPoolCache * cache = localCache();
+    if (cache == nullptr) [[unlikely]]
+    {
+        // Late in thread exit, hand out one slot and share the rest
+        sp::Uint32 count = 0;
+        FreeSlot * batch = popBatch(count);
+        if (batch == nullptr)
+            batch = grow(count);
+
+        if (count > 1)
+            pushBatch(batch->next, count - 1);
+        return batch;
+    }
+
+    if (cache->head == nullptr)
+    {
+        cache->head = popBatch(cache->count);
+        if (cache->head == nullptr)
+            cache->head = grow(cache->count);
+    }
+
+    FreeSlot * slot = cache->head;
+    cache->head     = slot->next;
+    --cache->count;
+    return slot;
+}
+
+void
+SlabPool::deallocate(void * slot) noexcept
+{
+    if (slot == nullptr)
+        return;
+
+    details::SlabPoolCache * cache = localCache();
+    if (cache == nullptr) [[unlikely]]
+    {
+        pushBatch(::new (slot) FreeSlot{}, 1);
+        return;
+    }
+
+    cache->head = ::new (slot) FreeSlot{cache->head};
+    if (++cache->count < 2 * batchSize)
+        return;
+
+    // Keep the most recently freed batch (likely in cache), share the rest
+    FreeSlot * last = cache->head;
+    for (sp::Uint32 i = 1; i < batchSize; ++i)
+        last = last->next;
+
+    pushBatch(last->next, cache->count - batchSize);
+    last->next   = nullptr;
+    cache->count = batchSize;
+}
+
+std::size_t
+SlabPool::getSlabCount() const
+{
+    std::lock_guard lock{slabsMutex};
+    return slabs.size();
+}
+
+std::size_t
+SlabPool::capacity() const
+{
+    return getSlabCount() * (slabSize / slotSize);
+}
+
+SlabPool::FreeSlot *
+SlabPool::popBatch(sp::Uint32 & count)
+{
+    sp::Uint64 top = batches.load(std::memory_order_acquire);
+    while (FreeSlot * batch = pointerOf<FreeSlot>(top))
+    {
+        // May read a batch that was just popped and reused, the tag then
+        // differs and the exchange fails
+        sp::Uint64 next = batch->nextBatch.load(std::memory_order_relaxed);
+        sp::Uint64 newTop = pack(pointerOf<FreeSlot>(next), highOf(top) + 1);
+
+        if (batches.compare_exchange_weak(
+                top,
+                newTop,
+                std::memory_order_acquire,
+                std::memory_order_acquire
+            ))
+        {
+            count = static_cast<sp::Uint32>(highOf(next));
+            return batch;
+        }
+    }
+
+    count = 0;
+    return nullptr;
+}
+
+void
+SlabPool::pushBatch(FreeSlot * batch, sp::Uint32 count) noexcept
+{
+    sp::Uint64 top = batches.load(std::memory_order_relaxed);
+    do
+    {
+        batch->nextBatch.store(
+            pack(pointerOf<FreeSlot>(top), count),
+            std::memory_order_relaxed
+        );
+    } while (!batches.compare_exchange_weak(
+        top,
+        pack(batch, highOf(top) + 1),
+        std::memory_order_release,
+        std::memory_order_relaxed
+    ));
+}
+
+SlabPool::FreeSlot *
+SlabPool::grow(sp::Uint32 & count)
+{
+    std::lock_guard lock{slabsMutex};
+
+    // Another thread may have grown the pool while we waited
+    if (FreeSlot * batch = popBatch(count))
+        return batch;
+
+    slabs.reserve(slabs.size() + 1);
+    auto * slab = static_cast<std::byte *>(
+        ::operator new(slabSize, std::align_val_t{slotAlign})
+    );
+    slabs.push_back(slab);
+
+    SPIRIT_ASSERT(
+        (pack(slab + slabSize, 0) & ~pointerMask) == 0,
+        "Addresses do not fit in {} bits",
+        pointerBits
+    );
+
+    // Link the slots in batches, keep the first batch
+    std::size_t nSlots = slabSize / slotSize;
+    FreeSlot * first   = nullptr;
+    sp::Uint32 firstCount = 0;
+    for (std::size_t start = 0; start < nSlots; start += batchSize)
+    {
+        auto n = static_cast<sp::Uint32>(std::min<std::size_t>(batchSize, nSlots - start));
+
+        FreeSlot * head = nullptr;
+        for (std::size_t i = start + n; i-- > start;)
+            head = ::new (slab + i * slotSize) FreeSlot{head};
+
+        if (first == nullptr)
+        {
+            first      = head;
+            firstCount = n;
+        }
+        else
+            pushBatch(head, n);
+    }
+
+    count = firstCount;
+    return first;
+}
+
+
+namespace details
+{
+
+SlabPool *
+sizeClassPool(std::size_t size, std::size_t align)
+{
+    constexpr std::size_t granularity = 16;
+    constexpr std::size_t nClasses    = 16;
+
+    if (size > granularity * nClasses || align > granularity)
+        return nullptr;
+
+    // Leaked, allocations may be released during static destruction
+    static SlabPool ** pools = []()
+    {
+        auto ** created = new SlabPool *[nClasses];
+        for (std::size_t i = 0; i < nClasses; ++i)
+            created[i] = new SlabPool{(i + 1) * granularity, granularity};
+        return created;
+    }();
+
+    return pools[(std::max<std::size_t>(size, 1) - 1) / granularity];
+}
+
+} // namespace details
+
+} // namespace sp
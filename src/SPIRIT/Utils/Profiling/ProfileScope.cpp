@@ -0,0 +1,454 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Utils/Profiling/ProfileScope.hpp"
+
+#include "SPIRIT/Base/Logging/details/FileBuf.hpp"
+#include "SPIRIT/Base/Utils/Time/TscClock.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace sp
+{
+namespace details
+{
+
+namespace
+{
+
+struct TraceEvent
+{
+    const char * name;
+    SourceLocation location;
+    sp::Int64 ns;
+    char phase;
+};
+
+// Written by a single thread, read by the trace writers.
+// An event is visible to readers once size is published.
+struct TraceChunk
+{
+    static constexpr std::size_t capacity = 1024;
+
+    std::array<TraceEvent, capacity> events;
+    std::atomic<std::size_t> size{0};
+    std::atomic<TraceChunk *> next{nullptr};
+};
+
+// Chunks of all buffers count against a single budget, events that
+// would need a chunk past it are dropped.
+std::atomic<std::size_t> maxChunks{(std::size_t{1} << 20) / TraceChunk::capacity};
+std::atomic<std::size_t> usedChunks{0};
+std::atomic<sp::Uint64> droppedEvents{0};
+
+TraceChunk *
+newChunk()
+{
+    usedChunks.fetch_add(1, std::memory_order_relaxed);
+    return new TraceChunk{};
+}
+
+// nullptr when over budget
+TraceChunk *
+tryNewChunk()
+{
+    if (usedChunks.fetch_add(1, std::memory_order_relaxed)
+        >= maxChunks.load(std::memory_order_relaxed))
+    {
+        usedChunks.fetch_sub(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    return new TraceChunk{};
+}
+
+void
+deleteChunk(TraceChunk * chunk)
+{
+    delete chunk;
+    usedChunks.fetch_sub(1, std::memory_order_relaxed);
+}
+
+// Single producer queue of events: the recording thread appends to
+// current, readers (serialized by the registry) consume from head.
+// A chunk is only freed once the producer moved past it.
+struct TraceBuffer
+{
+    explicit TraceBuffer(sp::Uint32 tid) : tid{tid}, head{newChunk()}, current{head} {}
+
+    ~TraceBuffer()
+    {
+        while (head)
+        {
+            TraceChunk * next = head->next.load(std::memory_order_relaxed);
+            deleteChunk(head);
+            head = next;
+        }
+    }
+
+    void
+    push(const TraceEvent & event)
+    {
+        std::size_t size = current->size.load(std::memory_order_relaxed);
+        if (size == TraceChunk::capacity)
+        {
+            TraceChunk * chunk = tryNewChunk();
+            if (chunk == nullptr)
+            {
+                droppedEvents.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            current->next.store(chunk, std::memory_order_release);
+            current = chunk;
+            size    = 0;
+        }
+
+        current->events[size] = event;
+        current->size.store(size + 1, std::memory_order_release);
+    }
+
+    // Unconsumed events, without consuming them
+    template <class F>
+    void
+    forEach(F && f) const
+    {
+        std::size_t start = readIndex;
+        for (const TraceChunk * chunk = head; chunk;
+             chunk                    = chunk->next.load(std::memory_order_acquire))
+        {
+            std::size_t size = chunk->size.load(std::memory_order_acquire);
+            for (std::size_t i = start; i < size; ++i)
+                f(chunk->events[i]);
+
+            start = 0;
+        }
+    }
+
+    // Consumes the events, frees the chunks the producer is done with.
+    // Stops at the events recorded before the call, a thread recording
+    // as fast as the buffer is drained would otherwise never let it end.
+    template <class F>
+    void
+    drain(F && f)
+    {
+        std::size_t remaining = this->size();
+        while (remaining > 0)
+        {
+            std::size_t size = std::min(
+                head->size.load(std::memory_order_acquire),
+                readIndex + remaining
+            );
+            for (std::size_t i = readIndex; i < size; ++i)
+                f(head->events[i]);
+
+            remaining -= size - readIndex;
+            readIndex = size;
+
+            TraceChunk * next = head->next.load(std::memory_order_acquire);
+            if (size < TraceChunk::capacity || next == nullptr)
+                return;
+
+            deleteChunk(head);
+            head      = next;
+            readIndex = 0;
+        }
+    }
+
+    std::size_t
+    size() const
+    {
+        std::size_t size = 0;
+        forEach([&size](const TraceEvent &) { ++size; });
+        return size;
+    }
+
+    bool
+    isEmpty() const
+    {
+        return head->next.load(std::memory_order_acquire) == nullptr
+               && readIndex == head->size.load(std::memory_order_acquire);
+    }
+
+    // Assigned under the registry's mutex
+    sp::Uint32 tid;
+
+    // Set when the recording thread exits
+    std::atomic<bool> isOrphaned{false};
+
+    // Consumer side
+    TraceChunk * head;
+    std::size_t readIndex = 0;
+
+    // Producer side
+    TraceChunk * current;
+};
+
+// Buffers outlive their threads so that the trace can be written
+// after they have exited. Drained buffers of exited threads are reused
+// by new threads, or freed by the next drain.
+struct TraceRegistry
+{
+    std::mutex mutex{};
+    std::vector<std::unique_ptr<TraceBuffer>> buffers{};
+    sp::Uint32 nextTid = 1;
+
+    // must be locked
+    void
+    eraseOrphans()
+    {
+        std::erase_if(buffers, [](const std::unique_ptr<TraceBuffer> & buffer) {
+            return buffer->isOrphaned.load(std::memory_order_acquire) && buffer->isEmpty();
+        });
+    }
+};
+
+TraceRegistry &
+traceRegistry()
+{
+    static TraceRegistry registry{};
+    return registry;
+}
+
+TraceBuffer *
+acquireTraceBuffer()
+{
+    TraceRegistry & registry = traceRegistry();
+    std::lock_guard lock{registry.mutex};
+
+    for (const auto & buffer : registry.buffers)
+    {
+        if (buffer->isOrphaned.load(std::memory_order_acquire) && buffer->isEmpty())
+        {
+            buffer->tid = registry.nextTid++;
+            buffer->isOrphaned.store(false, std::memory_order_relaxed);
+            return buffer.get();
+        }
+    }
+
+    return registry.buffers.emplace_back(std::make_unique<TraceBuffer>(registry.nextTid++)).get();
+}
+
+// Releases the thread's buffer when it exits
+struct ThreadTraceBuffer
+{
+    TraceBuffer * buffer = acquireTraceBuffer();
+
+    ~ThreadTraceBuffer();
+};
+
+// Events recorded by thread_local destructors after the buffer was
+// released are dropped.
+thread_local bool isThreadExiting = false;
+
+ThreadTraceBuffer::~ThreadTraceBuffer()
+{
+    isThreadExiting = true;
+    buffer->isOrphaned.store(true, std::memory_order_release);
+}
+
+TraceBuffer *
+threadTraceBuffer()
+{
+    if (isThreadExiting)
+        return nullptr;
+
+    thread_local ThreadTraceBuffer threadBuffer{};
+    return threadBuffer.buffer;
+}
+
+void
+writeJsonString(std::ostream & os, const char * str)
+{
+    os << '"';
+    for (; *str; ++str)
+    {
+        unsigned char ch = static_cast<unsigned char>(*str);
+        if (ch == '"' || ch == '\\')
+            os << '\\' << *str;
+        else if (ch < 0x20)
+        {
+            constexpr const char * hex = "0123456789abcdef";
+            os << "\\u00" << hex[ch >> 4] << hex[ch & 0xF];
+        }
+        else
+            os << *str;
+    }
+    os << '"';
+}
+
+void
+writeEvent(std::ostream & os, const TraceEvent & event, sp::Uint32 tid)
+{
+    // Chrome traces are in microseconds
+    sp::Int64 us = event.ns / 1000;
+    sp::Int64 ns = event.ns % 1000;
+
+    os << "{\"name\":";
+    writeJsonString(os, event.name);
+    os << ",\"ph\":\"" << event.phase << "\",\"ts\":" << us << '.';
+    os << static_cast<char>('0' + ns / 100) << static_cast<char>('0' + ns / 10 % 10)
+       << static_cast<char>('0' + ns % 10);
+    os << ",\"pid\":1,\"tid\":" << tid;
+
+    if (event.phase == 'B')
+    {
+        os << ",\"args\":{\"file\":";
+        writeJsonString(os, event.location.file_name());
+        os << ",\"line\":" << event.location.line() << ",\"function\":";
+        writeJsonString(os, event.location.function_name());
+        os << '}';
+    }
+
+    os << '}';
+}
+
+} // namespace
+
+void
+recordTraceEvent(const char * name, const SourceLocation & loc, char phase)
+{
+    TraceBuffer * buffer = threadTraceBuffer();
+    if (buffer == nullptr)
+        return;
+
+    sp::Int64 ns = TscClock::now().time_since_epoch().count();
+    buffer->push(TraceEvent{name, loc, ns, phase});
+}
+
+} // namespace details
+
+
+namespace
+{
+
+void
+writeTrace(std::ostream & os, bool isDraining)
+{
+    details::TraceRegistry & registry = details::traceRegistry();
+    std::lock_guard lock{registry.mutex};
+
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    for (const auto & buffer : registry.buffers)
+    {
+        auto write = [&](const details::TraceEvent & event) {
+            os << (first ? "\n" : ",\n");
+            details::writeEvent(os, event, buffer->tid);
+            first = false;
+        };
+
+        if (isDraining)
+            buffer->drain(write);
+        else
+            buffer->forEach(write);
+    }
+
+    os << "\n]}\n";
+
+    if (isDraining)
+        registry.eraseOrphans();
+}
+
+} // namespace
+
+
+void
+writeChromeTrace(std::ostream & os)
+{
+    writeTrace(os, false);
+}
+
+void
+drainChromeTrace(std::ostream & os)
+{
+    writeTrace(os, true);
+}
+
+bool
+writeChromeTrace(FILE * file)
+{
+    sp::details::OutFileBuf buf{file};
+    std::ostream os{&buf};
+
+    writeChromeTrace(os);
+    os.flush();
+
+    return static_cast<bool>(os);
+}
+
+std::size_t
+traceEventCount()
+{
+    details::TraceRegistry & registry = details::traceRegistry();
+    std::lock_guard lock{registry.mutex};
+
+    std::size_t count = 0;
+    for (const auto & buffer : registry.buffers)
+        count += buffer->size();
+
+    return count;
+}
+
+void
+clearTrace()
+{
+    details::TraceRegistry & registry = details::traceRegistry();
+    std::lock_guard lock{registry.mutex};
+
+    for (const auto & buffer : registry.buffers)
+        buffer->drain([](const details::TraceEvent &) {});
+
+    registry.eraseOrphans();
+}
+
+void
+setTraceCapacity(std::size_t maxEvents)
+{
+    std::size_t chunks = (maxEvents + details::TraceChunk::capacity - 1)
+                         / details::TraceChunk::capacity;
+    details::maxChunks.store(chunks, std::memory_order_relaxed);
+}
+
+std::size_t
+getTraceCapacity()
+{
+    return details::maxChunks.load(std::memory_order_relaxed) * details::TraceChunk::capacity;
+}
+
+sp::Uint64
+droppedTraceEventCount()
+{
+    return details::droppedEvents.load(std::memory_order_relaxed);
+}
+
+} // namespace sp
@@ -0,0 +1,409 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Utils/Profiling/Profiler.hpp"
+
+#include "SPIRIT/Base/Logging/Logger.hpp"
+#include "SPIRIT/Base/Logging/Message.hpp"
+#include "SPIRIT/Base/Utils/Time/Histogram.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+namespace sp
+{
+namespace details
+{
+
+struct ProfilerNode
+{
+    ProfilerNode(const char * name, ProfilerNode * parent)
+        : name{name}, parent{parent}
+    {
+    }
+
+    void
+    reset()
+    {
+        calls.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        childTotal.store(0, std::memory_order_relaxed);
+        min.store(std::numeric_limits<sp::Int64>::max(), std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+
+        for (auto & child : children)
+            child->reset();
+    }
+
+    const char * name;
+    ProfilerNode * parent;
+
+    // Only added to by the owning thread, with the thread's mutex held
+    std::vector<std::unique_ptr<ProfilerNode>> children{};
+
+    // Only written by the owning thread, and reset by collectors.
+    // A collector may see a call partly accounted for.
+    std::atomic<sp::Uint64> calls{0};
+    std::atomic<sp::Int64> total{0};
+    std::atomic<sp::Int64> childTotal{0};
+    std::atomic<sp::Int64> min{std::numeric_limits<sp::Int64>::max()};
+    std::atomic<sp::Int64> max{0};
+};
+
+namespace
+{
+
+// The owning thread reads its tree without locking, it is the only writer.
+// Other threads lock mutex to read the tree or reset the statistics, the
+// owning thread locks it to add nodes.
+struct ThreadProfile
+{
+    std::mutex mutex{};
+    ProfilerNode root{"", nullptr};
+    ProfilerNode * current = &root;
+
+    // Set when the owning thread exits
+    std::atomic<bool> isOrphaned{false};
+};
+
+// Profiles outlive their threads, their statistics remain in reports.
+// A new thread takes over an orphaned profile, scopes are merged by name
+// anyway, and orphans are removed once their statistics are reset.
+struct ProfileRegistry
+{
+    std::mutex mutex{};
+    std::vector<std::unique_ptr<ThreadProfile>> profiles{};
+
+    // must be locked
+    void
+    eraseOrphans()
+    {
+        std::erase_if(profiles, [](const std::unique_ptr<ThreadProfile> & profile) {
+            return profile->isOrphaned.load(std::memory_order_acquire);
+        });
+    }
+};
+
+ProfileRegistry &
+profileRegistry()
+{
+    static ProfileRegistry registry{};
+    return registry;
+}
+
+ThreadProfile *
+acquireThreadProfile()
+{
+    ProfileRegistry & registry = profileRegistry();
+    std::lock_guard lock{registry.mutex};
+
+    for (const auto & profile : registry.profiles)
+    {
+        if (profile->isOrphaned.load(std::memory_order_acquire))
+        {
+            profile->current = &profile->root;
+            profile->isOrphaned.store(false, std::memory_order_relaxed);
+            return profile.get();
+        }
+    }
+
+    return registry.profiles.emplace_back(std::make_unique<ThreadProfile>()).get();
+}
+
+struct ThreadProfileHolder
+{
+    ThreadProfile * profile = acquireThreadProfile();
+
+    ~ThreadProfileHolder();
+};
+
+// Scopes entered by thread_local destructors after the profile was
+// released are not accounted for
+thread_local bool isThreadExiting = false;
+
+ThreadProfileHolder::~ThreadProfileHolder()
+{
+    isThreadExiting = true;
+    profile->isOrphaned.store(true, std::memory_order_release);
+}
+
+ThreadProfile *
+threadProfile()
+{
+    if (isThreadExiting)
+        return nullptr;
+
+    thread_local ThreadProfileHolder holder{};
+    return holder.profile;
+}
+
+void
+merge(ProfileNode & dst, const ProfilerNode & src)
+{
+    for (const auto & srcChild : src.children)
+    {
+        auto it = std::find_if(
+            dst.children.begin(),
+            dst.children.end(),
+            [&](const ProfileNode & child) { return child.name == srcChild->name; }
+        );
+
+        if (it == dst.children.end())
+        {
+            dst.children.push_back(ProfileNode{srcChild->name});
+            it = dst.children.end() - 1;
+        }
+
+        ProfileNode & child = *it;
+        sp::Uint64 calls    = srcChild->calls.load(std::memory_order_relaxed);
+        if (calls > 0)
+        {
+            using std::chrono::nanoseconds;
+
+            sp::Int64 total = srcChild->total.load(std::memory_order_relaxed);
+            nanoseconds min{srcChild->min.load(std::memory_order_relaxed)};
+            nanoseconds max{srcChild->max.load(std::memory_order_relaxed)};
+
+            child.min = child.calls == 0 ? min : std::min(child.min, min);
+            child.max = std::max(child.max, max);
+
+            child.calls += calls;
+            child.inclusive += nanoseconds{total};
+            child.exclusive += nanoseconds{total - srcChild->childTotal.load(std::memory_order_relaxed)};
+        }
+
+        merge(child, *srcChild);
+    }
+}
+
+// Removes scopes that were not called, sorts the others
+void
+prune(ProfileNode & node)
+{
+    for (ProfileNode & child : node.children)
+        prune(child);
+
+    std::erase_if(node.children, [](const ProfileNode & child) {
+        return child.calls == 0 && child.children.empty();
+    });
+
+    std::sort(
+        node.children.begin(),
+        node.children.end(),
+        [](const ProfileNode & a, const ProfileNode & b) { return a.inclusive > b.inclusive; }
+    );
+}
+
+LogLevel
+shareLevel(double share)
+{
+    if (share >= 0.5)
+        return LogLevel::err;
+    if (share >= 0.25)
+        return LogLevel::warn;
+    if (share >= 0.1)
+        return LogLevel::info;
+    if (share >= 0.01)
+        return LogLevel::debug;
+
+    return LogLevel::trace;
+}
+
+void
+formatNode(
+    std::string & out,
+    const ProfileNode & node,
+    std::chrono::nanoseconds total,
+    std::size_t depth,
+    bool colors
+)
+{
+    double share = total.count() > 0
+                     ? static_cast<double>(node.inclusive.count()) / total.count()
+                     : 0;
+
+    if (colors)
+        out += sp::format("{}", defaultLevelColor(shareLevel(share)));
+
+    out += sp::format(
+        "\n{:>6.1f}% {:>10} {:>10} {:>10} {:>10} {:>10}  {:{}}{}",
+        share * 100,
+        node.calls,
+        formatDuration(node.inclusive),
+        formatDuration(node.exclusive),
+        formatDuration(node.min),
+        formatDuration(node.max),
+        "",
+        2 * depth,
+        node.name
+    );
+
+    if (colors)
+        out += sp::format("{}", sp::reset);
+
+    for (const ProfileNode & child : node.children)
+        formatNode(out, child, total, depth + 1, colors);
+}
+
+} // namespace
+
+ProfilerNode *
+enterProfilerNode(const char * name)
+{
+    ThreadProfile * profile = threadProfile();
+    if (!profile)
+        return nullptr;
+
+    ProfilerNode * parent = profile->current;
+    for (const auto & child : parent->children)
+    {
+        if (child->name == name || std::strcmp(child->name, name) == 0)
+            return profile->current = child.get();
+    }
+
+    std::lock_guard lock{profile->mutex};
+    parent->children.emplace_back(std::make_unique<ProfilerNode>(name, parent));
+    return profile->current = parent->children.back().get();
+}
+
+void
+exitProfilerNode(ProfilerNode * node, std::chrono::nanoseconds elapsed)
+{
+    ThreadProfile * profile = threadProfile();
+    if (!node || !profile)
+        return;
+
+    // The owning thread is the only writer, a reset may be lost
+    // with the call that is being accounted for
+    sp::Int64 ns = elapsed.count();
+    node->calls.fetch_add(1, std::memory_order_relaxed);
+    node->total.fetch_add(ns, std::memory_order_relaxed);
+    node->parent->childTotal.fetch_add(ns, std::memory_order_relaxed);
+
+    if (ns < node->min.load(std::memory_order_relaxed))
+        node->min.store(ns, std::memory_order_relaxed);
+    if (ns > node->max.load(std::memory_order_relaxed))
+        node->max.store(ns, std::memory_order_relaxed);
+
+    profile->current = node->parent;
+}
+
+} // namespace details
+
+
+ProfileNode
+collectProfile(bool reset)
+{
+    details::ProfileRegistry & registry = details::profileRegistry();
+    std::lock_guard registryLock{registry.mutex};
+
+    ProfileNode root{};
+    for (const auto & profile : registry.profiles)
+    {
+        std::lock_guard lock{profile->mutex};
+
+        details::merge(root, profile->root);
+        if (reset)
+            profile->root.reset();
+    }
+
+    if (reset)
+        registry.eraseOrphans();
+
+    details::prune(root);
+
+    for (const ProfileNode & child : root.children)
+        root.inclusive += child.inclusive;
+
+    return root;
+}
+
+void
+resetProfile()
+{
+    details::ProfileRegistry & registry = details::profileRegistry();
+    std::lock_guard registryLock{registry.mutex};
+
+    for (const auto & profile : registry.profiles)
+    {
+        std::lock_guard lock{profile->mutex};
+        profile->root.reset();
+    }
+
+    registry.eraseOrphans();
+}
+
+std::string
+formatProfile(const ProfileNode & root, bool colors)
+{
+    std::string out = sp::format(
+        "Profile, {} total\n{:>7} {:>10} {:>10} {:>10} {:>10} {:>10}  {}",
+        formatDuration(root.inclusive),
+        "share",
+        "calls",
+        "inclusive",
+        "exclusive",
+        "min",
+        "max",
+        "scope"
+    );
+
+    for (const ProfileNode & child : root.children)
+        details::formatNode(out, child, root.inclusive, 0, colors);
+
+    return out;
+}
+
+void
+logProfile(bool reset)
+{
+    std::string report = formatProfile(collectProfile(reset));
+    sp::spiritLog() << sp::Info{"{}", report};
+}
+
+bool
+logProfileEvery(std::chrono::nanoseconds period)
+{
+    static std::mutex mutex{};
+    static sp::Timer sinceReport{};
+
+    {
+        std::lock_guard lock{mutex};
+        if (sinceReport.getElapsed() < period)
+            return false;
+
+        sinceReport.reset();
+    }
+
+    logProfile(true);
+    return true;
+}
+
+} // namespace sp
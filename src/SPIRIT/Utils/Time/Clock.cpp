@@ -27,11 +27,57 @@
 #include <thread>
 
 #include "SPIRIT/Base/Utils/Time/Clock.hpp"
+#include "SPIRIT/Base/Utils/Memory/FrameArena.hpp"
+
+#if defined(SPIRIT_OS_LINUX)
+    #include <cerrno>
+    #include <time.h>
+#endif
 
 
 namespace sp
 {
 
+namespace
+{
+
+typedef std::chrono::steady_clock PacingClock;
+
+// Sleeps until shortly before deadline, then spins (yielding) until it.
+// Waking up from a sleep takes the scheduler's slack, spinning does not.
+void
+sleepUntil(PacingClock::time_point deadline, Clock::Nanoseconds spinPeriod)
+{
+    PacingClock::time_point wakeUp = deadline - spinPeriod;
+
+    if (PacingClock::now() < wakeUp)
+    {
+#if defined(SPIRIT_OS_LINUX)
+        // steady_clock is CLOCK_MONOTONIC
+        auto sinceEpoch = std::chrono::duration_cast<Clock::Nanoseconds>(
+            wakeUp.time_since_epoch()
+        );
+
+        timespec target{};
+        target.tv_sec  = static_cast<time_t>(sinceEpoch.count() / 1'000'000'000);
+        target.tv_nsec = static_cast<long>(sinceEpoch.count() % 1'000'000'000);
+
+        // absolute, so interruptions can resume with the same target
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr)
+               == EINTR)
+        {
+        }
+#else
+        std::this_thread::sleep_until(wakeUp);
+#endif
+    }
+
+    while (PacingClock::now() < deadline)
+        std::this_thread::yield();
+}
+
+} // namespace
+
 Clock::Nanoseconds
 Clock::getCurrentDt() const
 {
@@ -48,31 +94,44 @@ Clock::Clock(Nanoseconds minimumTickPeriod)
 sp::Clock::Nanoseconds
 sp::Clock::tick()
 {
-    Nanoseconds dt = this->timer.getElapsed();
+    if (this->tickPeriod > Nanoseconds{0})
+    {
+        PacingClock::time_point now = PacingClock::now();
+
+        // The next deadline follows the previous one, not the actual time of
+        // the last tick, so that sleeping inaccuracies don't accumulate.
+        // After falling behind by more than a period, restart from now
+        // rather than ticking without waiting to catch up.
+        if (!this->isPaced || now - this->deadline > this->tickPeriod)
+            this->deadline = now - this->timer.getElapsed();
+
+        this->deadline += this->tickPeriod;
+        this->isPaced = true;
+
+        sleepUntil(this->deadline, this->spinPeriod);
+    }
 
-    std::this_thread::sleep_for(tickPeriod - dt);
-    dt = this->timer.getElapsed();
+    Nanoseconds dt = this->timer.getElapsed();
     this->timer.reset();
 
-    this->ticks.push_back(dt);
-    if ( this->ticks.size() > 10 )
-        this->ticks.pop_front();
+    this->ticks.push(dt);
 
     return dt;
 }
 
 
-Clock::Nanoseconds
-Clock::getAverageTick() const
+void
+Clock::restart()
 {
-    Nanoseconds allTicks{0};
-    for ( const auto & tick : this->ticks )
-        allTicks += tick;
+    this->isPaced = false;
+    this->timer.reset();
+}
 
-    auto nTicks = this->ticks.size();
-    nTicks = nTicks == 0 ? 1 : nTicks;
 
-    return allTicks / nTicks;
+Clock::Nanoseconds
+Clock::getAverageTick() const
+{
+    return this->ticks.mean();
 }
 
 
@@ -84,11 +143,31 @@ Clock::getTicksPerSecond() const
 }
 
 
+void
+Clock::setSpinPeriod(Clock::Nanoseconds spin)
+{
+    this->spinPeriod = spin;
+}
+
+
 void
 Clock::setMinimumTickPeriod(Clock::Nanoseconds minTime)
 {
+    this->isPaced = false;
     this->tickPeriod = minTime;
 }
 
 
+WindowClock::Nanoseconds
+WindowClock::tick()
+{
+    Nanoseconds dt = Clock::tick();
+
+    if (this->frameArena != nullptr)
+        this->frameArena->nextFrame();
+
+    return dt;
+}
+
+
 } // namespace sp
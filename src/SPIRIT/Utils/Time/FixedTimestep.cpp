@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Utils/Time/FixedTimestep.hpp"
+
+#include "SPIRIT/Base/Error/Error.hpp"
+
+#include <algorithm>
+
+namespace sp
+{
+
+FixedTimestep::FixedTimestep(Nanoseconds step, sp::Int32 maxStepsPerFrame)
+    : step{step}, maxSteps{maxStepsPerFrame}
+{
+    SPIRIT_ASSERT(step.count() > 0, "The step must be positive");
+    SPIRIT_ASSERT(maxStepsPerFrame > 0, "At least one step must be allowed per frame");
+}
+
+sp::Int32
+FixedTimestep::advance(Nanoseconds frameTime)
+{
+    accumulator += std::max(frameTime, Nanoseconds{0});
+
+    sp::Int64 due    = accumulator / step;
+    lastDroppedSteps = std::max<sp::Int64>(due - maxSteps, 0);
+    due -= lastDroppedSteps;
+
+    accumulator -= (due + lastDroppedSteps) * step;
+    stepCount += static_cast<sp::Uint64>(due);
+    droppedSteps += static_cast<sp::Uint64>(lastDroppedSteps);
+
+    return static_cast<sp::Int32>(due);
+}
+
+void
+FixedTimestep::reset()
+{
+    accumulator = Nanoseconds{0};
+
+    // not a tick, the frame of an attached FrameArena goes on
+    clock.restart();
+}
+
+void
+FixedTimestep::setStep(Nanoseconds newStep)
+{
+    SPIRIT_ASSERT(newStep.count() > 0, "The step must be positive");
+
+    // keeps the same fraction of a step
+    accumulator = Nanoseconds{static_cast<sp::Int64>(alpha() * newStep.count())};
+    step        = newStep;
+}
+
+void
+FixedTimestep::setMaxStepsPerFrame(sp::Int32 maxStepsPerFrame)
+{
+    SPIRIT_ASSERT(maxStepsPerFrame > 0, "At least one step must be allowed per frame");
+    maxSteps = maxStepsPerFrame;
+}
+
+} // namespace sp
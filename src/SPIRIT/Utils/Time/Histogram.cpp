@@ -0,0 +1,409 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Utils/Time/Histogram.hpp"
+
+#include "SPIRIT/Base/Logging/Format.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace sp
+{
+namespace details
+{
+
+namespace
+{
+
+typedef HistogramSnapshot::Buckets Buckets;
+
+constexpr sp::Int64 noMin = std::numeric_limits<sp::Int64>::max();
+constexpr sp::Int64 noMax = std::numeric_limits<sp::Int64>::min();
+
+void
+atomicMin(std::atomic<sp::Int64> & extreme, sp::Int64 value)
+{
+    sp::Int64 current = extreme.load(std::memory_order_relaxed);
+    while (value < current
+           && !extreme.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+atomicMax(std::atomic<sp::Int64> & extreme, sp::Int64 value)
+{
+    sp::Int64 current = extreme.load(std::memory_order_relaxed);
+    while (value > current
+           && !extreme.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+} // namespace
+
+std::size_t
+threadShardIndex()
+{
+    static std::atomic<std::size_t> nThreads{0};
+    thread_local std::size_t index = nThreads.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+struct HistogramCounters
+{
+    std::array<std::atomic<sp::Uint64>, Buckets::count> counts{};
+
+    std::atomic<sp::Int64> sum{0};
+    std::atomic<sp::Int64> min{noMin};
+    std::atomic<sp::Int64> max{noMax};
+};
+
+// Double buffered: record() writes to the active counters, snapshot()
+// switches the active counters then takes the others once their
+// writers are done, so a record is entirely in one snapshot.
+//
+// Aligned so that shards of different threads don't share cache lines
+struct alignas(64) HistogramShard
+{
+    std::atomic<sp::Uint32> active{0};
+    std::array<std::atomic<sp::Uint32>, 2> writers{};
+    std::array<HistogramCounters, 2> counters{};
+};
+
+} // namespace details
+
+
+std::string
+formatDuration(std::chrono::nanoseconds duration)
+{
+    double ns = static_cast<double>(duration.count());
+
+    if (std::abs(ns) < 1e3)
+        return sp::format("{:.0f}ns", ns);
+    if (std::abs(ns) < 1e6)
+        return sp::format("{:.2f}us", ns / 1e3);
+    if (std::abs(ns) < 1e9)
+        return sp::format("{:.2f}ms", ns / 1e6);
+
+    return sp::format("{:.2f}s", ns / 1e9);
+}
+
+
+////////////////////////////////////////////////////////////
+// HistogramSnapshot
+////////////////////////////////////////////////////////////
+
+void
+HistogramSnapshot::record(Nanoseconds value, sp::Uint64 n)
+{
+    if (n == 0)
+        return;
+
+    if (counts.empty())
+        counts.resize(Buckets::count);
+
+    sp::Int64 ns = std::max<sp::Int64>(value.count(), 0);
+
+    counts[Buckets::indexOf(static_cast<sp::Uint64>(ns))] += n;
+
+    minValue = total == 0 ? ns : std::min(minValue, ns);
+    maxValue = total == 0 ? ns : std::max(maxValue, ns);
+    total += n;
+    sumValue += ns * static_cast<sp::Int64>(n);
+}
+
+void
+HistogramSnapshot::merge(const HistogramSnapshot & other)
+{
+    if (other.total == 0)
+        return;
+
+    if (counts.empty())
+        counts.resize(Buckets::count);
+
+    for (sp::Int32 i = 0; i < Buckets::count; ++i)
+        counts[i] += other.counts[i];
+
+    minValue = total == 0 ? other.minValue : std::min(minValue, other.minValue);
+    maxValue = total == 0 ? other.maxValue : std::max(maxValue, other.maxValue);
+    total += other.total;
+    sumValue += other.sumValue;
+}
+
+void
+HistogramSnapshot::clear()
+{
+    std::fill(counts.begin(), counts.end(), 0);
+
+    total    = 0;
+    sumValue = 0;
+    minValue = 0;
+    maxValue = 0;
+}
+
+HistogramSnapshot::Nanoseconds
+HistogramSnapshot::mean() const
+{
+    if (total == 0)
+        return Nanoseconds{0};
+
+    return Nanoseconds{sumValue / static_cast<sp::Int64>(total)};
+}
+
+HistogramSnapshot::Nanoseconds
+HistogramSnapshot::min() const
+{
+    return Nanoseconds{minValue};
+}
+
+HistogramSnapshot::Nanoseconds
+HistogramSnapshot::max() const
+{
+    return Nanoseconds{maxValue};
+}
+
+HistogramSnapshot::Nanoseconds
+HistogramSnapshot::percentile(double p) const
+{
+    if (total == 0)
+        return Nanoseconds{0};
+
+    // rank of the wanted value, in [1, total]
+    double clamped  = std::clamp(p, 0.0, 100.0);
+    sp::Uint64 rank = static_cast<sp::Uint64>(std::ceil(clamped / 100 * total));
+    rank            = std::max<sp::Uint64>(rank, 1);
+
+    // extremes are known exactly
+    if (rank == 1)
+        return min();
+    if (rank >= total)
+        return max();
+
+    sp::Uint64 seen = 0;
+    for (sp::Int32 i = 0; i < Buckets::count; ++i)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            sp::Uint64 mid = Buckets::lowerBound(i) + Buckets::width(i) / 2;
+            return Nanoseconds{std::clamp(static_cast<sp::Int64>(mid), minValue, maxValue)};
+        }
+    }
+
+    return max();
+}
+
+std::string
+HistogramSnapshot::render(sp::Int32 barWidth) const
+{
+    std::string out = sp::format(
+        "count {}, mean {}, min {}, max {}",
+        total,
+        formatDuration(mean()),
+        formatDuration(min()),
+        formatDuration(max())
+    );
+
+    if (total == 0)
+        return out;
+
+    out += sp::format(
+        "\np50 {}, p90 {}, p99 {}, p99.9 {}",
+        formatDuration(p50()),
+        formatDuration(p90()),
+        formatDuration(p99()),
+        formatDuration(p999())
+    );
+
+    // one row per power of two
+    constexpr sp::Int32 nRows = Buckets::count / Buckets::subBuckets;
+
+    std::array<sp::Uint64, nRows> rows{};
+    for (sp::Int32 i = 0; i < Buckets::count; ++i)
+        rows[i / Buckets::subBuckets] += counts[i];
+
+    sp::Int32 first = 0;
+    while (rows[first] == 0) ++first;
+
+    sp::Int32 last = nRows - 1;
+    while (rows[last] == 0) --last;
+
+    sp::Uint64 tallest = *std::max_element(rows.begin(), rows.end());
+
+    for (sp::Int32 row = first; row <= last; ++row)
+    {
+        sp::Uint64 lower = Buckets::lowerBound(row * Buckets::subBuckets);
+        sp::Uint64 upper = Buckets::lowerBound((row + 1) * Buckets::subBuckets);
+
+        auto length = static_cast<std::size_t>(
+            rows[row] == 0 ? 0 : std::max<sp::Uint64>(1, rows[row] * barWidth / tallest)
+        );
+
+        out += sp::format(
+            "\n[{:>9}, {:>9}) {:<{}} {}",
+            formatDuration(Nanoseconds{lower}),
+            formatDuration(Nanoseconds{upper}),
+            std::string(length, '#'),
+            barWidth,
+            rows[row]
+        );
+    }
+
+    return out;
+}
+
+
+////////////////////////////////////////////////////////////
+// Histogram
+////////////////////////////////////////////////////////////
+
+Histogram::Histogram(std::size_t nShards)
+    : nShards{nShards != 0 ? nShards : std::max(1u, std::thread::hardware_concurrency())},
+      shards{new std::atomic<details::HistogramShard *>[this->nShards]}
+{
+    for (std::size_t i = 0; i < this->nShards; ++i)
+        shards[i].store(nullptr, std::memory_order_relaxed);
+}
+
+Histogram::~Histogram()
+{
+    for (std::size_t i = 0; i < nShards; ++i)
+        delete shards[i].load(std::memory_order_relaxed);
+}
+
+details::HistogramShard &
+Histogram::shard()
+{
+    std::atomic<details::HistogramShard *> & slot
+        = shards[details::threadShardIndex() % nShards];
+
+    details::HistogramShard * shard = slot.load(std::memory_order_acquire);
+    if (shard) [[likely]]
+        return *shard;
+
+    // another thread of the same slot may be racing us
+    auto * created = new details::HistogramShard{};
+    if (slot.compare_exchange_strong(shard, created, std::memory_order_acq_rel))
+        return *created;
+
+    delete created;
+    return *shard;
+}
+
+void
+Histogram::record(Nanoseconds value)
+{
+    sp::Int64 ns = std::max<sp::Int64>(value.count(), 0);
+
+    details::HistogramShard & s = shard();
+
+    // Registers as a writer of the active counters. If snapshot()
+    // switched them meanwhile it may not have seen us, try again.
+    sp::Uint32 active = s.active.load(std::memory_order_seq_cst);
+    while (true)
+    {
+        s.writers[active].fetch_add(1, std::memory_order_seq_cst);
+
+        sp::Uint32 current = s.active.load(std::memory_order_seq_cst);
+        if (current == active) [[likely]]
+            break;
+
+        s.writers[active].fetch_sub(1, std::memory_order_release);
+        active = current;
+    }
+
+    details::HistogramCounters & c = s.counters[active];
+    c.counts[details::Buckets::indexOf(static_cast<sp::Uint64>(ns))].fetch_add(
+        1,
+        std::memory_order_relaxed
+    );
+    c.sum.fetch_add(ns, std::memory_order_relaxed);
+    details::atomicMin(c.min, ns);
+    details::atomicMax(c.max, ns);
+
+    s.writers[active].fetch_sub(1, std::memory_order_release);
+}
+
+HistogramSnapshot
+Histogram::snapshot(bool reset)
+{
+    std::lock_guard lock{snapshotMutex};
+
+    for (std::size_t i = 0; i < nShards; ++i)
+    {
+        details::HistogramShard * s = shards[i].load(std::memory_order_acquire);
+        if (!s)
+            continue;
+
+        sp::Uint32 taken = s->active.load(std::memory_order_relaxed);
+        s->active.store(1 - taken, std::memory_order_seq_cst);
+
+        // records that started before the switch
+        while (s->writers[taken].load(std::memory_order_seq_cst) != 0)
+            std::this_thread::yield();
+
+        // no one writes to them until the next switch
+        details::HistogramCounters & c = s->counters[taken];
+
+        HistogramSnapshot shard{};
+        shard.counts.resize(details::Buckets::count);
+        for (sp::Int32 b = 0; b < details::Buckets::count; ++b)
+        {
+            shard.counts[b] = c.counts[b].load(std::memory_order_relaxed);
+            shard.total += shard.counts[b];
+            c.counts[b].store(0, std::memory_order_relaxed);
+        }
+
+        shard.sumValue = c.sum.load(std::memory_order_relaxed);
+        shard.minValue = c.min.load(std::memory_order_relaxed);
+        shard.maxValue = c.max.load(std::memory_order_relaxed);
+        c.sum.store(0, std::memory_order_relaxed);
+        c.min.store(details::noMin, std::memory_order_relaxed);
+        c.max.store(details::noMax, std::memory_order_relaxed);
+
+        retained.merge(shard);
+    }
+
+    HistogramSnapshot merged = retained;
+    if (reset)
+        retained = HistogramSnapshot{};
+
+    return merged;
+}
+
+void
+Histogram::reset()
+{
+    (void)snapshot(true);
+}
+
+} // namespace sp
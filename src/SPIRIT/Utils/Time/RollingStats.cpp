@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Utils/Time/RollingStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace sp
+{
+
+RollingStats::RollingStats(std::size_t windowSize)
+{
+    setWindowSize(windowSize);
+}
+
+void
+RollingStats::push(Nanoseconds value)
+{
+    sp::Int64 v = std::max<sp::Int64>(value.count(), 0);
+
+    if (count == window.size())
+    {
+        sp::Int64 old = window[head];
+        sum -= old;
+        sumSquares -= static_cast<double>(old) * static_cast<double>(old);
+        --histogram[Buckets::indexOf(static_cast<sp::Uint64>(old))];
+
+        extremesAreDirty |= old == minValue || old == maxValue;
+    }
+    else
+        ++count;
+
+    if (count == 1)
+    {
+        minValue = v;
+        maxValue = v;
+    }
+    else
+    {
+        minValue = std::min(minValue, v);
+        maxValue = std::max(maxValue, v);
+    }
+
+    window[head] = v;
+    sum += v;
+    sumSquares += static_cast<double>(v) * static_cast<double>(v);
+    ++histogram[Buckets::indexOf(static_cast<sp::Uint64>(v))];
+
+    head = (head + 1) % window.size();
+
+    // Adding and removing squares accumulates rounding errors,
+    // recomputing once per window keeps it amortized O(1)
+    if (head == 0)
+    {
+        sumSquares = 0;
+        for (std::size_t i = 0; i < count; ++i)
+            sumSquares += static_cast<double>(window[i]) * static_cast<double>(window[i]);
+    }
+}
+
+void
+RollingStats::setWindowSize(std::size_t windowSize)
+{
+    window.assign(std::max<std::size_t>(windowSize, 1), 0);
+    clear();
+}
+
+void
+RollingStats::clear()
+{
+    head       = 0;
+    count      = 0;
+    sum        = 0;
+    sumSquares = 0;
+    histogram.fill(0);
+
+    minValue         = 0;
+    maxValue         = 0;
+    extremesAreDirty = false;
+}
+
+RollingStats::Nanoseconds
+RollingStats::last() const
+{
+    if (count == 0)
+        return Nanoseconds{0};
+
+    return Nanoseconds{window[(head + window.size() - 1) % window.size()]};
+}
+
+RollingStats::Nanoseconds
+RollingStats::mean() const
+{
+    if (count == 0)
+        return Nanoseconds{0};
+
+    return Nanoseconds{sum / static_cast<sp::Int64>(count)};
+}
+
+RollingStats::Nanoseconds
+RollingStats::stddev() const
+{
+    if (count == 0)
+        return Nanoseconds{0};
+
+    double n        = static_cast<double>(count);
+    double avg      = static_cast<double>(sum) / n;
+    double variance = sumSquares / n - avg * avg;
+
+    return Nanoseconds{static_cast<sp::Int64>(std::sqrt(std::max(variance, 0.0)))};
+}
+
+RollingStats::Nanoseconds
+RollingStats::min() const
+{
+    recomputeExtremes();
+    return Nanoseconds{minValue};
+}
+
+RollingStats::Nanoseconds
+RollingStats::max() const
+{
+    recomputeExtremes();
+    return Nanoseconds{maxValue};
+}
+
+RollingStats::Nanoseconds
+RollingStats::percentile(double p) const
+{
+    if (count == 0)
+        return Nanoseconds{0};
+
+    // rank of the wanted value, in [1, count]
+    double clamped  = std::clamp(p, 0.0, 100.0);
+    sp::Uint64 rank = static_cast<sp::Uint64>(std::ceil(clamped / 100 * count));
+    rank            = std::max<sp::Uint64>(rank, 1);
+
+    // extremes are known exactly
+    if (rank == 1)
+        return min();
+    if (rank >= count)
+        return max();
+
+    sp::Uint64 seen = 0;
+    for (sp::Int32 i = 0; i < Buckets::count; ++i)
+    {
+        seen += histogram[i];
+        if (seen >= rank)
+        {
+            sp::Uint64 mid = Buckets::lowerBound(i) + Buckets::width(i) / 2;
+
+            recomputeExtremes();
+            return Nanoseconds{std::clamp(static_cast<sp::Int64>(mid), minValue, maxValue)};
+        }
+    }
+
+    return max();
+}
+
+void
+RollingStats::recomputeExtremes() const
+{
+    if (!extremesAreDirty)
+        return;
+
+    auto [minIt, maxIt] = std::minmax_element(window.begin(), window.begin() + count);
+    minValue         = *minIt;
+    maxValue         = *maxIt;
+    extremesAreDirty = false;
+}
+
+} // namespace sp
@@ -0,0 +1,329 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Utils/Time/TimerWheel.hpp"
+
+#include "SPIRIT/Base/Error/Error.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+namespace sp
+{
+
+////////////////////////////////////////////////////////////
+// TimerWheel
+////////////////////////////////////////////////////////////
+
+TimerWheel::TimerWheel(Nanoseconds resolution) : resolution{resolution}
+{
+    SPIRIT_ASSERT(resolution.count() > 0, "The resolution must be positive");
+    heads.fill(nil);
+}
+
+TimerWheel::TimerId
+TimerWheel::schedule(Nanoseconds delay, Callback callback)
+{
+    // counted from the start of the current tick, so it never fires early.
+    // Whole ticks and fractions are summed apart, so that nothing overflows
+    sp::Uint64 res   = static_cast<sp::Uint64>(resolution.count());
+    sp::Uint64 ns    = static_cast<sp::Uint64>(std::max<sp::Int64>(delay.count(), 0));
+    sp::Uint64 rest  = ns % res + static_cast<sp::Uint64>(remainder.count());
+    sp::Uint64 ticks = ns / res + rest / res + (rest % res != 0 ? 1 : 0);
+    ticks            = std::clamp<sp::Uint64>(ticks, 1, maxTicks);
+
+    sp::Uint32 index;
+    if (freeList != nil)
+    {
+        index    = freeList;
+        freeList = nodes[index].next;
+    }
+    else
+    {
+        SPIRIT_ASSERT(nodes.size() < nil, "Too many timeouts");
+        index = static_cast<sp::Uint32>(nodes.size());
+        nodes.emplace_back();
+    }
+
+    Node & node    = nodes[index];
+    node.callback = std::move(callback);
+    node.expiry   = now + ticks;
+
+    insert(index);
+    ++count;
+
+    return (static_cast<TimerId>(node.generation) << 32) | index;
+}
+
+bool
+TimerWheel::cancel(TimerId id)
+{
+    auto index      = static_cast<sp::Uint32>(id);
+    auto generation = static_cast<sp::Uint32>(id >> 32);
+
+    if (index >= nodes.size() || nodes[index].list == nil
+        || nodes[index].generation != generation)
+        return false;
+
+    unlink(index);
+    release(index);
+    --count;
+
+    return true;
+}
+
+std::size_t
+TimerWheel::advance(Nanoseconds elapsed)
+{
+    sp::Uint64 res   = static_cast<sp::Uint64>(resolution.count());
+    sp::Uint64 ns    = static_cast<sp::Uint64>(std::max<sp::Int64>(elapsed.count(), 0));
+    sp::Uint64 rest  = ns % res + static_cast<sp::Uint64>(remainder.count());
+    sp::Uint64 ticks = ns / res + rest / res;
+    remainder        = Nanoseconds{static_cast<sp::Int64>(rest % res)};
+
+    sp::Uint64 target = now + ticks;
+    std::size_t fired = 0;
+
+    while (count > 0)
+    {
+        sp::Uint64 next = nextExpiry();
+        if (next > target)
+            break;
+
+        // nothing happens in the ticks before
+        now = next - 1;
+        fired += tick();
+    }
+
+    now = target;
+    return fired;
+}
+
+void
+TimerWheel::clear()
+{
+    for (sp::Uint32 i = 0; i < nodes.size(); ++i)
+    {
+        if (nodes[i].list != nil)
+            release(i);
+    }
+
+    heads.fill(nil);
+    occupied.fill(0);
+    count = 0;
+}
+
+sp::Uint64
+TimerWheel::nextExpiry() const
+{
+    // A wheel's occupied slots are ahead of now's digit, each is reached
+    // when the finer digits are all 0.
+    sp::Uint64 next = std::numeric_limits<sp::Uint64>::max();
+
+    for (sp::Int32 level = 0; level < nLevels; ++level)
+    {
+        sp::Int32 shift  = level * slotBits;
+        sp::Uint64 digit = (now >> shift) & (nSlots - 1);
+        sp::Uint64 ahead = occupied[level] & ~((sp::Uint64{2} << digit) - 1);
+        if (ahead == 0)
+            continue;
+
+        sp::Int32 coarser = shift + slotBits;
+        sp::Uint64 base   = coarser >= 64 ? 0 : (now >> coarser) << coarser;
+        sp::Uint64 slot   = static_cast<sp::Uint64>(std::countr_zero(ahead));
+
+        next = std::min(next, base | (slot << shift));
+    }
+
+    return next;
+}
+
+void
+TimerWheel::insert(sp::Uint32 index)
+{
+    Node & node = nodes[index];
+
+    // the wheel of the highest digit that differs from now
+    sp::Uint64 differs = node.expiry ^ now;
+    sp::Int32 level    = differs == 0 ? 0 : (63 - std::countl_zero(differs)) / slotBits;
+    sp::Int32 slot     = static_cast<sp::Int32>(node.expiry >> (level * slotBits)) & (nSlots - 1);
+
+    node.list = static_cast<sp::Uint32>(level * nSlots + slot);
+    node.prev = nil;
+    node.next = heads[node.list];
+
+    if (node.next != nil)
+        nodes[node.next].prev = index;
+
+    heads[node.list] = index;
+    occupied[level] |= sp::Uint64{1} << slot;
+}
+
+void
+TimerWheel::unlink(sp::Uint32 index)
+{
+    Node & node = nodes[index];
+
+    if (node.prev != nil)
+        nodes[node.prev].next = node.next;
+    else
+        heads[node.list] = node.next;
+
+    if (node.next != nil)
+        nodes[node.next].prev = node.prev;
+
+    if (heads[node.list] == nil)
+        occupied[node.list / nSlots] &= ~(sp::Uint64{1} << (node.list % nSlots));
+}
+
+void
+TimerWheel::release(sp::Uint32 index)
+{
+    Node & node = nodes[index];
+
+    node.callback = nullptr;
+    node.list     = nil;
+    node.next     = freeList;
+    freeList      = index;
+
+    // invalidates the ids of this node, 0 is kept for invalid ids
+    if (++node.generation == 0)
+        node.generation = 1;
+}
+
+std::size_t
+TimerWheel::tick()
+{
+    ++now;
+
+    // Coarser wheels turn when the digits below them are all 0,
+    // their current slot cascades into the finer wheels.
+    sp::Int32 turned = 0;
+    while (turned + 1 < nLevels && (now & ((sp::Uint64{1} << ((turned + 1) * slotBits)) - 1)) == 0)
+        ++turned;
+
+    for (sp::Int32 level = turned; level > 0; --level)
+    {
+        sp::Uint32 list = static_cast<sp::Uint32>(
+            level * nSlots + ((now >> (level * slotBits)) & (nSlots - 1))
+        );
+
+        sp::Uint32 index = heads[list];
+        heads[list]      = nil;
+        occupied[level] &= ~(sp::Uint64{1} << (list % nSlots));
+
+        while (index != nil)
+        {
+            sp::Uint32 next = nodes[index].next;
+            insert(index);
+            index = next;
+        }
+    }
+
+    // everything in the finest wheel's slot expires now
+    sp::Uint32 list   = static_cast<sp::Uint32>(now & (nSlots - 1));
+    std::size_t fired = 0;
+
+    while (heads[list] != nil)
+    {
+        sp::Uint32 index = heads[list];
+        unlink(index);
+
+        Callback callback = std::move(nodes[index].callback);
+        release(index);
+        --count;
+
+        // may schedule timeouts, which expire after now
+        callback();
+        ++fired;
+    }
+
+    return fired;
+}
+
+
+////////////////////////////////////////////////////////////
+// TimerWheelThread
+////////////////////////////////////////////////////////////
+
+TimerWheelThread::TimerWheelThread(Nanoseconds resolution)
+    : wheel{resolution}, clock{resolution}, thread{&TimerWheelThread::run, this}
+{
+}
+
+TimerWheelThread::~TimerWheelThread()
+{
+    stop();
+}
+
+TimerWheelThread::TimerId
+TimerWheelThread::schedule(Nanoseconds delay, Callback callback)
+{
+    std::lock_guard lock{mutex};
+    return wheel.schedule(delay, std::move(callback));
+}
+
+bool
+TimerWheelThread::cancel(TimerId id)
+{
+    std::lock_guard lock{mutex};
+    return wheel.cancel(id);
+}
+
+std::size_t
+TimerWheelThread::size() const
+{
+    std::lock_guard lock{mutex};
+    return wheel.size();
+}
+
+void
+TimerWheelThread::stop()
+{
+    if (!thread.joinable())
+        return;
+
+    running.store(false, std::memory_order_relaxed);
+    thread.join();
+}
+
+void
+TimerWheelThread::run()
+{
+    // timeouts tolerate a late wake up, don't spin for precision
+    clock.setSpinPeriod(Nanoseconds{0});
+
+    while (running.load(std::memory_order_relaxed))
+    {
+        Nanoseconds elapsed = clock.tick(); // waits for the resolution
+
+        std::lock_guard lock{mutex};
+        wheel.advance(elapsed);
+    }
+}
+
+} // namespace sp
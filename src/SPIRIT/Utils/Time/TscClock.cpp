@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////
+//
+// Spirit
+// Copyright (C) 2022 Matthieu Beauchamp-Boulay
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+#include "SPIRIT/Base/Utils/Time/TscClock.hpp"
+
+#if SPIRIT_HAS_TSC && !defined(_MSC_VER)
+    #include <cpuid.h>
+#endif
+
+
+namespace sp
+{
+namespace details
+{
+
+constexpr std::chrono::milliseconds calibrationPeriod{5};
+
+bool
+isTscInvariant()
+{
+#if SPIRIT_HAS_TSC
+    // CPUID 0x80000007, EDX bit 8: invariant TSC
+    unsigned int regs[4]{};
+
+    #if defined(_MSC_VER)
+    int info[4]{};
+    __cpuid(info, 0x80000000);
+    if (static_cast<unsigned int>(info[0]) < 0x80000007)
+        return false;
+
+    __cpuid(info, 0x80000007);
+    regs[3] = static_cast<unsigned int>(info[3]);
+    #else
+    if (__get_cpuid_max(0x80000000, nullptr) < 0x80000007)
+        return false;
+
+    __get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3]);
+    #endif
+
+    return (regs[3] & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+sp::Int64
+steadyNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()
+    )
+        .count();
+}
+
+TscCalibration
+calibrateTsc()
+{
+    TscCalibration calibration{};
+
+#if SPIRIT_HAS_TSC
+    if (!isTscInvariant())
+        return calibration;
+
+    sp::Uint64 startTicks = __rdtsc();
+    sp::Int64 start       = steadyNs();
+
+    sp::Int64 end = start;
+    while (end - start < std::chrono::nanoseconds{calibrationPeriod}.count())
+        end = steadyNs();
+
+    sp::Uint64 endTicks = __rdtsc();
+
+    if (endTicks <= startTicks)
+        return calibration;
+
+    calibration.nsPerTick
+        = static_cast<double>(end - start) / static_cast<double>(endTicks - startTicks);
+    calibration.baseTicks = endTicks;
+    calibration.baseNs    = end;
+    calibration.usable    = true;
+#endif
+
+    return calibration;
+}
+
+} // namespace details
+} // namespace sp
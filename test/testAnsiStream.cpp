@@ -152,4 +152,50 @@ TEST_CASE("Ansi Stream on connex classes")
 
         REQUIRE(true);
     }
-}
\ No newline at end of file
+
+    SECTION("Redundant TextStyles")
+    {
+        sp::AnsiStreamWrapper<std::stringstream> on{true};
+        std::stringstream expected{};
+
+        SECTION("Typed escapes")
+        {
+            on << sp::reset << sp::red << sp::red << "a" << sp::reset << sp::reset;
+            expected << sp::red << "a" << sp::reset;
+            REQUIRE(on->str() == expected.str());
+        }
+
+        SECTION("Combined escapes")
+        {
+            on << sp::Escapes{sp::reset, sp::green, sp::onDefault} << "a"
+               << sp::Escapes{sp::green, sp::bold} << "b";
+            expected << sp::green << "a" << sp::bold << "b";
+            REQUIRE(on->str() == expected.str());
+        }
+
+        SECTION("Escapes inside strings")
+        {
+            on << sp::format("{}a{}{}b", sp::cyan, sp::cyan, sp::reset)
+               << std::string{"\x1b[0;36mc\x1b[m"};
+            expected << sp::cyan << "a" << sp::reset << "b"
+                     << "\x1b[0;36mc\x1b[m";
+            REQUIRE(on->str() == expected.str());
+        }
+
+        SECTION("Terminal controls are kept")
+        {
+            on << sp::EraseLine{} << sp::EraseLine{} << "a\x1b[2Kb";
+            expected << sp::EraseLine{} << sp::EraseLine{} << "a\x1b[2Kb";
+            REQUIRE(on->str() == expected.str());
+        }
+
+        SECTION("Invalidation")
+        {
+            on << sp::red;
+            on.invalidateTextStyle();
+            on << sp::red << sp::reset << sp::reset;
+            expected << sp::red << sp::red << sp::reset;
+            REQUIRE(on->str() == expected.str());
+        }
+    }
+}
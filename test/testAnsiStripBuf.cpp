@@ -0,0 +1,113 @@
+#include "SPIRIT/Base/Logging/AnsiStripBuf.hpp"
+#include "SPIRIT/Base/Logging/AnsiStream.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdio>
+#include <sstream>
+
+namespace
+{
+
+// Counts the calls made to it, to check that text is forwarded in one piece
+class CountingBuf : public std::stringbuf
+{
+public:
+
+    int nWrites = 0;
+
+protected:
+
+    std::streamsize
+    xsputn(const char * str, std::streamsize n) override
+    {
+        ++nWrites;
+        return std::stringbuf::xsputn(str, n);
+    }
+};
+
+} // namespace
+
+
+TEST_CASE("AnsiStripBuf")
+{
+    std::stringbuf target{};
+    sp::AnsiStripBuf strip{&target};
+    std::ostream os{&strip};
+
+    SECTION("Removes escapes")
+    {
+        os << sp::toStr(sp::red) << "red" << sp::toStr(sp::Escapes{sp::reset, sp::onBlue})
+           << " bold" << sp::toStr(sp::MoveCursorTo{3, 4})
+           << sp::toStr(sp::EraseLine{}) << ".";
+
+        os << sp::toStr(sp::FgGradient{"grad", {0, 0, 0}, {255, 255, 255}});
+
+        // two characters escape, OSC terminated by BEL and by ST
+        os << "\x1b" "7a\x1b]0;title\a" "b\x1b]8;;url\x1b\\c";
+
+        REQUIRE(target.str() == "red bold.gradabc");
+        REQUIRE_FALSE(strip.inSequence());
+    }
+
+    SECTION("Escapes split across writes")
+    {
+        std::string text = "ab\x1b[38;2;1;2;3mcd\x1b[0mef\x1b]0;t\x1b\\g";
+        for (char c : text) os.put(c);
+
+        os.write("h\x1b[3", 4);
+        REQUIRE(strip.inSequence());
+        os.write("1", 1);
+        os.write("mi", 2);
+
+        REQUIRE(target.str() == "abcdefghi");
+    }
+
+    SECTION("Text is forwarded without copies")
+    {
+        CountingBuf counting{};
+        strip.setTarget(&counting);
+
+        std::string plain(1000, 'x');
+        os.write(plain.data(), plain.size());
+        REQUIRE(counting.nWrites == 1);
+
+        os.write("a\x1b[1mb", 6);
+        REQUIRE(counting.nWrites == 3);
+        REQUIRE(counting.str() == plain + "ab");
+    }
+
+    SECTION("Over a FileBuf")
+    {
+        FILE * f = std::tmpfile();
+        REQUIRE(f != nullptr);
+
+        {
+            sp::details::OutFileBuf fileBuf{f};
+            sp::AnsiStripBuf fileStrip{&fileBuf};
+            std::ostream fileOs{&fileStrip};
+
+            std::string longText(300, 'y');
+            fileOs << sp::toStr(sp::green) << "ok" << sp::toStr(sp::reset)
+                   << longText << std::flush;
+        }
+
+        std::rewind(f);
+        char buf[512]{};
+        std::size_t nRead = std::fread(buf, 1, sizeof(buf), f);
+        std::fclose(f);
+
+        REQUIRE(std::string(buf, nRead) == "ok" + std::string(300, 'y'));
+    }
+}
+
+TEST_CASE("AnsiStreamWrapper strips rendered escapes when disabled")
+{
+    sp::AnsiStreamWrapper<std::stringstream> out{false};
+
+    out << sp::toStr(sp::red) << "red" << sp::reset << " "
+        << std::string{sp::toStr(sp::bold)};
+    out.writeText("a\x1b[", 3);
+    out.writeText("1mb", 3);
+
+    REQUIRE(out->str() == "red ab");
+}
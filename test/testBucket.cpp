@@ -0,0 +1,186 @@
+#include "SPIRIT/Base/Utils/Containers/Bucket.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Counts live objects to catch leaks and double destructions
+struct Tracked
+{
+    static inline int alive = 0;
+
+    int value;
+
+    Tracked(int value) : value{value} { ++alive; }
+
+    Tracked(const Tracked & other) : value{other.value} { ++alive; }
+
+    Tracked(Tracked && other) noexcept : value{other.value}
+    {
+        other.value = -1;
+        ++alive;
+    }
+
+    Tracked &
+    operator=(const Tracked &) = default;
+
+    ~Tracked() { --alive; }
+};
+
+template <class Container>
+std::vector<int>
+values(const Container & bucket)
+{
+    std::vector<int> result{};
+    for (const auto & elem : bucket) result.push_back(elem.value);
+    return result;
+}
+
+template <class Container>
+std::vector<int>
+ints(const Container & bucket)
+{
+    return std::vector<int>(bucket.begin(), bucket.end());
+}
+
+} // namespace
+
+TEST_CASE("Bucket")
+{
+    SECTION("Capacity")
+    {
+        sp::Bucket<4, int> bucket{};
+        REQUIRE(bucket.empty());
+        REQUIRE(bucket.capacity() == 4);
+
+        for (int i = 0; i < 4; ++i) REQUIRE(bucket.push_back(i));
+        REQUIRE(bucket.isFull());
+
+        // Insertions into a full bucket are ignored
+        REQUIRE_FALSE(bucket.push_back(4));
+        REQUIRE(bucket.emplace(bucket.begin(), 4) == bucket.end());
+        REQUIRE(bucket.insert(bucket.begin(), 3, 4) == 0);
+        REQUIRE(ints(bucket) == std::vector<int>{0, 1, 2, 3});
+
+        bucket.pop_back();
+        REQUIRE(bucket.back() == 2);
+        REQUIRE(bucket.at(2) == 2);
+        REQUIRE_THROWS_AS(bucket.at(3), sp::AssertionError);
+
+        // Checked against the size, not the capacity
+        const auto & constBucket = bucket;
+        REQUIRE_THROWS_AS(constBucket.at(3), sp::AssertionError);
+
+        bucket.clear();
+        bucket.pop_back(); // no-op
+        REQUIRE(bucket.empty());
+    }
+
+    SECTION("Insert and erase")
+    {
+        sp::Bucket<8, int> bucket{};
+        for (int i : {1, 2, 5}) bucket.push_back(i);
+
+        REQUIRE(*bucket.insert(bucket.begin(), 0) == 0);
+        REQUIRE(bucket.insert(bucket.begin() + 3, 2, 3) == 2);
+        REQUIRE(ints(bucket) == std::vector<int>{0, 1, 2, 3, 3, 5});
+
+        std::vector<int> more{6, 7, 8, 9};
+        auto rest = bucket.insert(bucket.end(), more.begin(), more.end());
+        REQUIRE(rest == more.begin() + 2);
+        REQUIRE(ints(bucket) == std::vector<int>{0, 1, 2, 3, 3, 5, 6, 7});
+
+        auto next = bucket.erase(bucket.begin() + 3);
+        REQUIRE(*next == 3);
+        next = bucket.erase(bucket.begin() + 1, bucket.begin() + 4);
+        REQUIRE(*next == 5);
+        REQUIRE(ints(bucket) == std::vector<int>{0, 5, 6, 7});
+
+        // Inserting an element of the bucket into itself
+        bucket.insert(bucket.begin(), bucket.back());
+        REQUIRE(ints(bucket) == std::vector<int>{7, 0, 5, 6, 7});
+    }
+
+    SECTION("Lifetimes")
+    {
+        Tracked::alive = 0;
+        {
+            sp::Bucket<6, Tracked> bucket{};
+            for (int i = 0; i < 4; ++i) bucket.emplace_back(i);
+
+            bucket.emplace(bucket.begin() + 1, 10);
+            REQUIRE(values(bucket) == std::vector<int>{0, 10, 1, 2, 3});
+            REQUIRE(Tracked::alive == 5);
+
+            bucket.erase(bucket.begin(), bucket.begin() + 2);
+            REQUIRE(values(bucket) == std::vector<int>{1, 2, 3});
+            REQUIRE(Tracked::alive == 3);
+
+            sp::Bucket<6, Tracked> copy{bucket};
+            REQUIRE(Tracked::alive == 6);
+
+            copy.pop_back();
+            bucket = copy;
+            REQUIRE(values(bucket) == std::vector<int>{1, 2});
+            REQUIRE(Tracked::alive == 4);
+
+            sp::Bucket<6, Tracked> moved{std::move(copy)};
+            REQUIRE(copy.empty());
+            REQUIRE(values(moved) == std::vector<int>{1, 2});
+            REQUIRE(Tracked::alive == 4);
+
+            bucket = std::move(moved);
+            REQUIRE(moved.empty());
+            REQUIRE(Tracked::alive == 2);
+        }
+        REQUIRE(Tracked::alive == 0);
+    }
+
+    SECTION("Const elements")
+    {
+        sp::Bucket<4, const std::string> bucket{};
+        bucket.emplace_back("b");
+        bucket.emplace(bucket.begin(), "a");
+        bucket.push_back("c");
+        bucket.erase(bucket.begin() + 1);
+
+        REQUIRE(bucket.size() == 2);
+        REQUIRE(bucket[0] == "a");
+        REQUIRE(bucket[1] == "c");
+    }
+}
+
+
+namespace sp::traits
+{
+
+template <class T>
+struct isTriviallyRelocatable<std::unique_ptr<T>> : public std::true_type
+{
+};
+
+} // namespace sp::traits
+
+TEST_CASE("Bucket relocation")
+{
+    static_assert(sp::traits::isTriviallyRelocatable_v<int>);
+    static_assert(!sp::traits::isTriviallyRelocatable_v<Tracked>);
+
+    // unique_ptr is relocated with memmove, ownership must follow
+    sp::Bucket<4, std::unique_ptr<int>> bucket{};
+    for (int i : {1, 3}) bucket.push_back(std::make_unique<int>(i));
+
+    bucket.insert(bucket.begin() + 1, std::make_unique<int>(2));
+    bucket.erase(bucket.begin());
+    REQUIRE(bucket.size() == 2);
+    REQUIRE(*bucket[0] == 2);
+    REQUIRE(*bucket[1] == 3);
+
+    sp::Bucket<4, std::unique_ptr<int>> moved{std::move(bucket)};
+    REQUIRE(bucket.empty());
+    REQUIRE(*moved.front() == 2);
+}
@@ -0,0 +1,139 @@
+#include "SPIRIT/Base/Utils/Containers/BucketList.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+template <class Container>
+std::vector<int>
+sorted(const Container & list)
+{
+    std::vector<int> result{};
+    for (const auto & elem : list) result.push_back(*elem);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("BucketList")
+{
+    // unique_ptrs catch leaks and double destructions
+    sp::BucketList<std::unique_ptr<int>, 4> list{};
+
+    SECTION("Stable pointers")
+    {
+        std::vector<int *> elems{};
+        for (int i = 0; i < 10; ++i)
+            elems.push_back(list.emplace(std::make_unique<int>(i))->get());
+
+        REQUIRE(list.size() == 10);
+        REQUIRE(list.capacity() == 12);
+
+        std::vector<const std::unique_ptr<int> *> slots{};
+        for (const auto & elem : list) slots.push_back(&elem);
+
+        // Erase every other element, the rest must not move
+        for (auto it = list.begin(); it != list.end();)
+            it = **it % 2 == 0 ? list.erase(it) : std::next(it);
+
+        REQUIRE(sorted(list) == std::vector<int>{1, 3, 5, 7, 9});
+        for (const auto & elem : list)
+        {
+            REQUIRE(std::find(slots.begin(), slots.end(), &elem) != slots.end());
+            REQUIRE(elems[*elem] == elem.get());
+        }
+
+        // Freed slots are reused before allocating
+        for (int i = 10; i < 15; ++i) list.emplace(std::make_unique<int>(i));
+        REQUIRE(list.capacity() == 12);
+
+        for (const auto & elem : list)
+            REQUIRE(std::find(slots.begin(), slots.end(), &elem) != slots.end());
+    }
+
+    SECTION("Erasing through a pointer")
+    {
+        auto * first = &*list.emplace(std::make_unique<int>(1));
+        list.emplace(std::make_unique<int>(2));
+
+        auto it = list.getIterator(first);
+        REQUIRE(it != list.end());
+        list.erase(it);
+
+        REQUIRE(list.getIterator(first) == list.end()); // slot is free
+        REQUIRE(sorted(list) == std::vector<int>{2});
+    }
+
+    SECTION("Chunks are released")
+    {
+        for (int i = 0; i < 12; ++i) list.emplace(std::make_unique<int>(i));
+
+        // Emptying the middle chunk keeps it in reserve
+        for (auto it = list.begin(); it != list.end();)
+            it = (*it && 4 <= **it && **it < 8) ? list.erase(it) : std::next(it);
+        REQUIRE(list.size() == 8);
+        REQUIRE(list.capacity() == 12);
+
+        list.clear();
+        REQUIRE(list.empty());
+        REQUIRE(list.begin() == list.end());
+        REQUIRE(list.capacity() == 4);
+
+        list.shrink_to_fit();
+        REQUIRE(list.capacity() == 0);
+
+        list.emplace(std::make_unique<int>(0));
+        REQUIRE(list.capacity() == 4);
+    }
+
+    SECTION("Random operations")
+    {
+        std::mt19937 gen{42};
+        std::vector<int> expected{};
+        std::vector<std::unique_ptr<int> *> handles{};
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            if (handles.empty() || gen() % 3 != 0)
+            {
+                handles.push_back(&*list.emplace(std::make_unique<int>(i)));
+                expected.push_back(i);
+                continue;
+            }
+
+            std::size_t pick = gen() % handles.size();
+            std::erase(expected, **handles[pick]);
+            list.erase(list.getIterator(handles[pick]));
+            handles.erase(handles.begin() + pick);
+        }
+
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(list.size() == expected.size());
+        REQUIRE(sorted(list) == expected);
+
+        sp::BucketList<std::unique_ptr<int>, 4> moved{std::move(list)};
+        REQUIRE(list.empty());
+        REQUIRE(sorted(moved) == expected);
+    }
+}
+
+TEST_CASE("BucketList copies")
+{
+    sp::BucketList<int, 100> list{};
+    for (int i = 0; i < 250; ++i) list.insert(i);
+
+    sp::BucketList<int, 100> copy{list};
+    REQUIRE(copy.size() == 250);
+
+    std::vector<int> values(copy.begin(), copy.end());
+    std::sort(values.begin(), values.end());
+    REQUIRE(values.front() == 0);
+    REQUIRE(values.back() == 249);
+    REQUIRE(std::adjacent_find(values.begin(), values.end()) == values.end());
+}
@@ -0,0 +1,102 @@
+#include "SPIRIT/Base/Utils/Time/Clock.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Clock pacing")
+{
+    SECTION("Average rate matches the period")
+    {
+        sp::WindowClock clock{};
+        clock.setFps(100);
+        clock.setStatsWindow(50);
+
+        clock.tick();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 50; ++i) clock.tick();
+        auto total = std::chrono::steady_clock::now() - start;
+
+        // ticks are never early, the upper bounds only catch gross errors
+        // since a loaded machine may wake up arbitrarily late, see
+        // "Clock pacing accuracy" for the tight bounds
+        REQUIRE(total >= 495ms);
+        REQUIRE(total < 2s);
+
+        // a late first tick shortens the window a little
+        REQUIRE(clock.getFps() < 110.f);
+        REQUIRE(clock.getFps() > 25.f);
+    }
+
+    SECTION("Late ticks do not wait")
+    {
+        sp::Clock clock{50ms};
+        clock.tick();
+
+        std::this_thread::sleep_for(120ms);
+
+        // waiting would take about a period
+        auto start = std::chrono::steady_clock::now();
+        clock.tick();
+        REQUIRE(std::chrono::steady_clock::now() - start < 40ms);
+
+        // the schedule restarted from the late tick, no catching up
+        clock.tick();
+        REQUIRE(clock.getStats().last() >= 50ms - 100us);
+    }
+
+    SECTION("No period")
+    {
+        sp::Clock clock{};
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 1000; ++i) clock.tick();
+        REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+    }
+}
+
+// Hidden, needs an idle machine: run with "[pacing]"
+TEST_CASE("Clock pacing accuracy", "[.pacing]")
+{
+    SECTION("Deadlines don't drift")
+    {
+        sp::WindowClock clock{};
+        clock.setFps(100);
+        clock.setStatsWindow(50);
+
+        clock.tick();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 50; ++i) clock.tick();
+        auto total = std::chrono::steady_clock::now() - start;
+
+        // only the first and last wake ups may be late
+        REQUIRE(total >= 495ms);
+        REQUIRE(total < 500ms + 30ms);
+
+        REQUIRE(clock.getFps() > 95.f);
+        REQUIRE(clock.getFps() < 105.f);
+    }
+
+    SECTION("Late ticks return immediately")
+    {
+        sp::Clock clock{5ms};
+        clock.tick();
+
+        std::this_thread::sleep_for(20ms);
+
+        auto start = std::chrono::steady_clock::now();
+        clock.tick();
+        REQUIRE(std::chrono::steady_clock::now() - start < 4ms);
+
+        clock.tick();
+        REQUIRE(clock.getStats().last() >= 5ms - 100us);
+    }
+
+    SECTION("No period")
+    {
+        sp::Clock clock{};
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < 1000; ++i) clock.tick();
+        REQUIRE(std::chrono::steady_clock::now() - start < 100ms);
+    }
+}
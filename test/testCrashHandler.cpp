@@ -0,0 +1,146 @@
+#include "SPIRIT/Base/Error/CrashHandler.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(SPIRIT_OS_WINDOWS)
+    #include <sys/wait.h>
+    #include <unistd.h>
+
+namespace
+{
+
+std::string
+readFile(const char * path)
+{
+    std::ifstream file{path};
+    std::stringstream ss{};
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+} // namespace
+
+
+TEST_CASE("Crash handler")
+{
+    const char * logPath = "crashLog.txt";
+    const char * errPath = "crashErr.txt";
+
+    // more than FileBuf's buffer, some of it is in the FILE's buffer
+    std::string longLine(300, 'x');
+
+    pid_t pid = fork();
+    REQUIRE(pid >= 0);
+
+    if (pid == 0)
+    {
+        FILE * err = std::fopen(errPath, "w");
+        dup2(fileno(err), STDERR_FILENO);
+
+        FILE * log = std::fopen(logPath, "w");
+        sp::AnsiFileStream stream{log, sp::ansiMode::never};
+
+        // chain to the default action, not to the test framework's handler
+        std::signal(SIGSEGV, SIG_DFL);
+
+        sp::installCrashHandler();
+        sp::registerCrashFlush(stream);
+
+        stream << longLine << "\nlast words";
+        std::raise(SIGSEGV);
+
+        _exit(0); // not reached
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+
+    REQUIRE(WIFSIGNALED(status));
+    REQUIRE(WTERMSIG(status) == SIGSEGV);
+
+    REQUIRE(readFile(logPath) == longLine + "\nlast words");
+
+    std::string err = readFile(errPath);
+    REQUIRE(err.find("received fatal signal SIGSEGV") != std::string::npos);
+    REQUIRE(err.find(" 0# 0x") != std::string::npos);
+
+    std::remove(logPath);
+    std::remove(errPath);
+}
+
+TEST_CASE("Crash buffers unregister when destroyed")
+{
+    // fill the registry with buffers that go out of scope,
+    // the second round gets the same slots back
+    int registered[2]{};
+    for (int round = 0; round < 2; ++round)
+    {
+        std::vector<std::unique_ptr<sp::details::OutFileBuf>> bufs{};
+        for (int i = 0; i < 64; ++i)
+        {
+            bufs.push_back(std::make_unique<sp::details::OutFileBuf>(stdout));
+            registered[round] += sp::registerCrashFlush(*bufs.back());
+        }
+    }
+
+    REQUIRE(registered[0] > 0);
+    REQUIRE(registered[0] < 64);
+    REQUIRE(registered[1] == registered[0]);
+
+    sp::details::OutFileBuf buf{stdout};
+    REQUIRE(sp::registerCrashFlush(buf));
+    sp::unregisterCrashFlush(buf);
+}
+
+TEST_CASE("Crash handler installation")
+{
+    struct sigaction previous{};
+    sigaction(SIGABRT, nullptr, &previous);
+
+    sp::installCrashHandler();
+    sp::installCrashHandler();
+
+    struct sigaction current{};
+    sigaction(SIGABRT, nullptr, &current);
+    REQUIRE(current.sa_handler != previous.sa_handler);
+
+    sp::uninstallCrashHandler();
+    sigaction(SIGABRT, nullptr, &current);
+    REQUIRE(current.sa_handler == previous.sa_handler);
+}
+
+TEST_CASE("Crash stacks are per thread")
+{
+    auto currentStack = []() {
+        stack_t stack{};
+        sigaltstack(nullptr, &stack);
+        return stack;
+    };
+
+    stack_t mainStack = currentStack();
+
+    stack_t before{};
+    stack_t after{};
+    std::thread thread{[&]() {
+        before = currentStack();
+        sp::installCrashStack();
+        sp::installCrashStack();
+        after = currentStack();
+    }};
+    thread.join();
+
+    REQUIRE_FALSE(after.ss_flags & SS_DISABLE);
+    REQUIRE(after.ss_size >= 64 * 1024);
+    REQUIRE(after.ss_sp != before.ss_sp);
+    REQUIRE(currentStack().ss_sp == mainStack.ss_sp);
+}
+
+#endif
@@ -0,0 +1,146 @@
+#include "SPIRIT/Base/Error/Error.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+void
+validate(int value)
+{
+    SPIRIT_ASSERT(value >= 0, "{} is negative", value);
+}
+
+struct NonCopyable
+{
+    NonCopyable() = default;
+    NonCopyable(const NonCopyable &) = delete;
+
+    friend std::ostream &
+    operator<<(std::ostream & os, const NonCopyable &)
+    {
+        return os << "non copyable";
+    }
+};
+
+} // namespace
+
+
+TEST_CASE("SpiritError")
+{
+    SECTION("Message")
+    {
+        sp::SpiritError error{"Oh no! {} != {}", 1, 2};
+        REQUIRE(error.message() == "Oh no! 1 != 2");
+
+        std::string what = error.what();
+        REQUIRE(what.find("Error message: \nOh no! 1 != 2\n") != std::string::npos);
+
+#if SPIRIT_USE_STACKTRACE
+        REQUIRE(what.rfind("Stacktrace:\n", 0) == 0);
+#endif
+
+        // built once
+        REQUIRE(error.what() == error.what());
+
+        std::stringstream ss{};
+        ss << error;
+        REQUIRE(ss.str() == what);
+    }
+
+    SECTION("Copies share the explanation")
+    {
+        sp::SpiritError error{"copied"};
+        sp::SpiritError copy{error};
+
+        REQUIRE(copy.message() == "copied");
+        REQUIRE(copy.what() == error.what());
+    }
+
+    SECTION("Moved from errors stay printable")
+    {
+        sp::SpiritError error{"moved"};
+        sp::SpiritError moved{std::move(error)};
+        REQUIRE(moved.message() == "moved");
+        REQUIRE(error.message() == "moved");
+        REQUIRE(std::string{error.what()} == moved.what());
+
+        sp::SpiritError other{"other"};
+        other = std::move(moved);
+        REQUIRE(other.message() == "moved");
+        REQUIRE(moved.message() == "moved");
+    }
+
+#if SPIRIT_ASSERT_LEVEL >= SPIRIT_ASSERT_LEVEL_CHEAP
+    SECTION("Caught assertions")
+    {
+        validate(1);
+
+        int nCaught = 0;
+        for (int i = 0; i < 100; ++i)
+        {
+            try
+            {
+                validate(-i - 1);
+            }
+            catch (const sp::AssertionError & e)
+            {
+                nCaught += e.message().find("is negative") != std::string_view::npos;
+            }
+        }
+
+        REQUIRE(nCaught == 100);
+    }
+
+    SECTION("Assertion arguments are not copied")
+    {
+        NonCopyable value{};
+        bool isCaught = false;
+        try
+        {
+            SPIRIT_ASSERT(false, "{}", value);
+        }
+        catch (const sp::AssertionError & e)
+        {
+            isCaught = e.message() == "non copyable";
+        }
+        REQUIRE(isCaught);
+    }
+#endif
+
+    SECTION("Assertion levels")
+    {
+        int nEvaluated = 0;
+        auto count     = [&nEvaluated]() { return ++nEvaluated; };
+
+        // arguments are only evaluated on failure
+        SPIRIT_ASSERT(true, "{}", count());
+        REQUIRE(nEvaluated == 0);
+
+#if SPIRIT_ASSERT_LEVEL == SPIRIT_ASSERT_LEVEL_OFF
+        SPIRIT_ASSERT(count() < 0, "off");
+        SPIRIT_ASSERT_FULL(count() < 0, "off");
+        REQUIRE(nEvaluated == 0);
+#else
+        REQUIRE_THROWS_AS(
+            [&]() { SPIRIT_ASSERT(false, "{}", count()); }(),
+            sp::AssertionError
+        );
+        REQUIRE(nEvaluated == 1);
+#endif
+
+#if SPIRIT_ASSERT_LEVEL >= SPIRIT_ASSERT_LEVEL_FULL
+        REQUIRE_THROWS_AS(
+            [&]() { SPIRIT_ASSERT_FULL(count() < 0, "full"); }(),
+            sp::AssertionError
+        );
+        REQUIRE(nEvaluated == 2);
+#elif SPIRIT_ASSERT_LEVEL == SPIRIT_ASSERT_LEVEL_CHEAP
+        // not evaluated at all
+        SPIRIT_ASSERT_FULL(count() < 0, "full");
+        REQUIRE(nEvaluated == 1);
+#endif
+    }
+}
@@ -0,0 +1,85 @@
+#include "SPIRIT/Base/Utils/Time/FixedTimestep.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("FixedTimestep")
+{
+    sp::FixedTimestep loop{10ms, 3};
+
+    SECTION("Accumulator")
+    {
+        REQUIRE(loop.advance(25ms) == 2);
+        REQUIRE(loop.alpha() == 0.5);
+
+        REQUIRE(loop.advance(4ms) == 0);
+        REQUIRE(loop.advance(1ms) == 1); // 5ms + 4ms + 1ms
+        REQUIRE(loop.alpha() == 0);
+
+        REQUIRE(loop.advance(-1ms) == 0);
+        REQUIRE(loop.getStepCount() == 3);
+        REQUIRE(loop.getDroppedSteps() == 0);
+    }
+
+    SECTION("Catch up is capped")
+    {
+        REQUIRE(loop.advance(57ms) == 3);
+        REQUIRE(loop.getLastDroppedSteps() == 2);
+        REQUIRE(loop.alpha() == 0.7); // the fraction is kept
+
+        REQUIRE(loop.advance(13ms) == 2);
+        REQUIRE(loop.getLastDroppedSteps() == 0);
+
+        REQUIRE(loop.getStepCount() == 5);
+        REQUIRE(loop.getDroppedSteps() == 2);
+    }
+
+    SECTION("Settings")
+    {
+        loop.advance(5ms);
+        loop.setStep(20ms);
+        REQUIRE(loop.getStep() == 20ms);
+        REQUIRE(loop.alpha() == 0.5);
+
+        loop.setMaxStepsPerFrame(1);
+        REQUIRE(loop.advance(50ms) == 1);
+        REQUIRE(loop.getLastDroppedSteps() == 2);
+
+        loop.reset();
+        REQUIRE(loop.alpha() == 0);
+    }
+
+    SECTION("Frames")
+    {
+        loop.getClock().setFps(200); // 5ms frames
+        loop.reset();
+
+        std::vector<double> alphas{};
+        sp::Int32 nUpdates = 0;
+
+        for (int i = 0; i < 20; ++i)
+        {
+            sp::Int32 ran = loop.frame(
+                [&](std::chrono::nanoseconds dt) {
+                    REQUIRE(dt == 10ms);
+                    ++nUpdates;
+                },
+                [&](double alpha) { alphas.push_back(alpha); }
+            );
+            REQUIRE(ran <= 3);
+        }
+
+        // ~100ms of frames, loosely for slow machines
+        REQUIRE(nUpdates >= 8);
+        REQUIRE(static_cast<sp::Uint64>(nUpdates) == loop.getStepCount());
+        REQUIRE(alphas.size() == 20);
+        for (double alpha : alphas)
+            REQUIRE((0 <= alpha && alpha < 1));
+
+        REQUIRE(loop.getClock().getStats().size() > 0);
+    }
+}
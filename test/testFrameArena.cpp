@@ -0,0 +1,138 @@
+#include "SPIRIT/Base/Logging/Format.hpp"
+#include "SPIRIT/Base/Utils/Memory/FrameArena.hpp"
+#include "SPIRIT/Base/Utils/Time/Clock.hpp"
+#include "SPIRIT/Base/Utils/Time/FixedTimestep.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+
+namespace
+{
+
+bool
+isAligned(const void * p, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+} // namespace
+
+TEST_CASE("FrameArena")
+{
+    sp::FrameArena arena{1024};
+
+    SECTION("Bump allocation")
+    {
+        auto * a = static_cast<char *>(arena.allocate(10, 1));
+        auto * b = static_cast<char *>(arena.allocate(10, 1));
+        REQUIRE(b == a + 10);
+
+        void * c = arena.allocate(8, 64);
+        REQUIRE(isAligned(c, 64));
+        REQUIRE(arena.getFrameUsage() >= 28);
+        REQUIRE(arena.getOverflowCount() == 0);
+
+        auto ints = arena.allocateArray<int>(16);
+        REQUIRE(ints.size() == 16);
+        REQUIRE(isAligned(ints.data(), alignof(int)));
+        for (int i : ints) REQUIRE(i == 0);
+    }
+
+    SECTION("Double buffering")
+    {
+        auto * first = static_cast<char *>(arena.allocate(100));
+        std::memset(first, 1, 100);
+
+        // frame N is still valid during frame N + 1
+        arena.nextFrame();
+        auto * second = static_cast<char *>(arena.allocate(100));
+        std::memset(second, 2, 100);
+        REQUIRE(second != first);
+        REQUIRE(first[99] == 1);
+        REQUIRE(arena.getFrameUsage() == 100);
+
+        // and reused by frame N + 2
+        arena.nextFrame();
+        REQUIRE(arena.getFrameUsage() == 0);
+        REQUIRE(arena.allocate(100) == first);
+        REQUIRE(second[0] == 2);
+        REQUIRE(arena.getFrameCount() == 2);
+    }
+
+    SECTION("Overflow grows the buffers")
+    {
+        std::vector<char *> allocations{};
+        for (int i = 0; i < 40; ++i)
+        {
+            allocations.push_back(static_cast<char *>(arena.allocate(100, 1)));
+            std::memset(allocations.back(), i, 100);
+        }
+
+        REQUIRE(arena.getOverflowCount() > 0);
+        REQUIRE(arena.getHighWaterMark() == 4000);
+        for (int i = 0; i < 40; ++i) REQUIRE(allocations[i][99] == i);
+
+        // a buffer is grown when it is reused
+        std::size_t overflows = arena.getOverflowCount();
+        for (int frame = 0; frame < 4; ++frame)
+        {
+            arena.nextFrame();
+            REQUIRE(arena.getCapacity() >= 4000);
+            for (int i = 0; i < 40; ++i) arena.allocate(100, 1);
+        }
+        REQUIRE(arena.getOverflowCount() == overflows);
+
+        // larger than a buffer
+        void * huge = arena.allocate(1 << 20, 256);
+        REQUIRE(isAligned(huge, 256));
+        std::memset(huge, 0, 1 << 20);
+    }
+
+    SECTION("memory_resource")
+    {
+        std::pmr::memory_resource & resource = arena.getResource();
+        REQUIRE(resource.is_equal(resource));
+        REQUIRE_FALSE(resource.is_equal(*std::pmr::new_delete_resource()));
+
+        std::pmr::vector<int> values{&resource};
+        for (int i = 0; i < 1000; ++i) values.push_back(i);
+        REQUIRE(values[999] == 999);
+
+        std::pmr::string text = sp::format(resource, "{} + {} = {}", 1, 2, 3);
+        REQUIRE(text == "1 + 2 = 3");
+        REQUIRE(text.get_allocator().resource() == &resource);
+        REQUIRE(arena.getFrameUsage() >= 1000 * sizeof(int));
+    }
+}
+
+TEST_CASE("FrameArena with a WindowClock")
+{
+    sp::FrameArena arena{};
+    sp::WindowClock clock{};
+
+    clock.setFrameArena(&arena);
+    REQUIRE(clock.getFrameArena() == &arena);
+
+    arena.allocate(64);
+    clock.tick();
+    REQUIRE(arena.getFrameCount() == 1);
+    REQUIRE(arena.getFrameUsage() == 0);
+
+    // restarting is not a new frame
+    arena.allocate(64);
+    clock.restart();
+    REQUIRE(arena.getFrameCount() == 1);
+    REQUIRE(arena.getFrameUsage() == 64);
+
+    clock.setFrameArena(nullptr);
+    clock.tick();
+    REQUIRE(arena.getFrameCount() == 1);
+
+    sp::FixedTimestep loop{std::chrono::milliseconds{10}};
+    loop.getClock().setFrameArena(&arena);
+    loop.reset();
+    REQUIRE(arena.getFrameCount() == 1);
+}
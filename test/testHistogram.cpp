@@ -0,0 +1,183 @@
+#include "SPIRIT/Base/Utils/Time/Clock.hpp"
+#include "SPIRIT/Base/Utils/Time/Histogram.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+using ns = std::chrono::nanoseconds;
+
+TEST_CASE("HistogramSnapshot")
+{
+    sp::HistogramSnapshot hist{};
+
+    SECTION("Empty")
+    {
+        REQUIRE(hist.count() == 0);
+        REQUIRE(hist.mean() == ns{0});
+        REQUIRE(hist.p99() == ns{0});
+        REQUIRE(hist.render() == "count 0, mean 0ns, min 0ns, max 0ns");
+    }
+
+    SECTION("Exact statistics")
+    {
+        for (int v : {10, 20, 30, 40}) hist.record(ns{v});
+        hist.record(ns{-5}); // counts as 0
+
+        REQUIRE(hist.count() == 5);
+        REQUIRE(hist.sum() == ns{100});
+        REQUIRE(hist.mean() == ns{20});
+        REQUIRE(hist.min() == ns{0});
+        REQUIRE(hist.max() == ns{40});
+
+        // small values have exact buckets
+        REQUIRE(hist.percentile(50) == ns{20});
+        REQUIRE(hist.percentile(0) == ns{0});
+        REQUIRE(hist.percentile(100) == ns{40});
+
+        hist.clear();
+        REQUIRE(hist.count() == 0);
+        REQUIRE(hist.max() == ns{0});
+    }
+
+    SECTION("Percentiles")
+    {
+        std::vector<sp::Int64> values{};
+        std::mt19937 gen{7};
+        std::lognormal_distribution<double> dist{13, 1}; // ~0.5ms median
+
+        for (int i = 0; i < 100'000; ++i)
+        {
+            values.push_back(static_cast<sp::Int64>(dist(gen)) + 1);
+            hist.record(ns{values.back()});
+        }
+        std::sort(values.begin(), values.end());
+
+        for (double p : {10.0, 50.0, 90.0, 99.0, 99.9})
+        {
+            auto exact = static_cast<double>(
+                values[static_cast<std::size_t>(p / 100 * values.size()) - 1]
+            );
+            auto approx = static_cast<double>(hist.percentile(p).count());
+            REQUIRE(std::abs(approx - exact) / exact < 0.02);
+        }
+    }
+
+    SECTION("Merge")
+    {
+        sp::HistogramSnapshot other{};
+        hist.record(ns{1000}, 3);
+        other.record(ns{5}, 2);
+        other.record(ns{1'000'000});
+
+        hist.merge(other);
+        hist.merge(sp::HistogramSnapshot{});
+
+        REQUIRE(hist.count() == 6);
+        REQUIRE(hist.min() == ns{5});
+        REQUIRE(hist.max() == ns{1'000'000});
+        REQUIRE(hist.sum() == ns{1'003'010});
+    }
+
+    SECTION("Render")
+    {
+        hist.record(ns{10}, 2);
+        hist.record(ns{100});
+        hist.record(ns{1500}, 4);
+
+        std::string text = hist.render(8);
+        REQUIRE(text.starts_with("count 7, mean 874ns, min 10ns, max 1.50us\np50 "));
+        REQUIRE(text.find("[     64ns,     128ns) ##       1") != std::string::npos);
+        REQUIRE(text.find("[      0ns,      32ns) ####     2") != std::string::npos);
+        REQUIRE(text.find("[   1.02us,    2.05us) ######## 4") != std::string::npos);
+    }
+}
+
+TEST_CASE("Histogram")
+{
+    sp::Histogram hist{4};
+    REQUIRE(hist.shardCount() == 4);
+    REQUIRE(sp::Histogram{}.shardCount() >= 1);
+
+    SECTION("Concurrent records")
+    {
+        constexpr int nThreads = 8;
+        constexpr int nRecords = 20'000;
+
+        std::vector<std::thread> threads{};
+        for (int t = 0; t < nThreads; ++t)
+            threads.emplace_back([&hist, t]() {
+                for (int i = 1; i <= nRecords; ++i)
+                    hist.record(ns{i + t});
+            });
+
+        for (auto & thread : threads)
+            thread.join();
+
+        sp::HistogramSnapshot snap = hist.snapshot();
+        REQUIRE(snap.count() == nThreads * nRecords);
+        REQUIRE(snap.min() == ns{1});
+        REQUIRE(snap.max() == ns{nRecords + nThreads - 1});
+
+        // reset on read
+        REQUIRE(hist.snapshot(true).count() == nThreads * nRecords);
+        REQUIRE(hist.snapshot().count() == 0);
+        REQUIRE(hist.snapshot().max() == ns{0});
+    }
+
+    SECTION("Reset during records")
+    {
+        constexpr int nThreads = 4;
+        constexpr int nRecords = 20'000;
+
+        std::vector<std::thread> threads{};
+        for (int t = 0; t < nThreads; ++t)
+            threads.emplace_back([&hist, t]() {
+                for (int i = 0; i < nRecords; ++i)
+                    hist.record(ns{t + 1});
+            });
+
+        // each record is in exactly one snapshot, with its sum and extremes
+        sp::Uint64 total = 0;
+        auto take = [&]() {
+            sp::HistogramSnapshot snap = hist.snapshot(true);
+            total += snap.count();
+            if (snap.count() == 0)
+                return;
+
+            REQUIRE(snap.min() >= ns{1});
+            REQUIRE(snap.max() <= ns{nThreads});
+            REQUIRE(snap.min() <= snap.max());
+            REQUIRE(snap.mean() >= snap.min());
+            REQUIRE(snap.mean() <= snap.max());
+        };
+
+        for (int i = 0; i < 200; ++i)
+        {
+            take();
+            std::this_thread::yield();
+        }
+
+        for (auto & thread : threads)
+            thread.join();
+        take();
+
+        REQUIRE(total == nThreads * nRecords);
+    }
+
+    SECTION("Timers and clocks")
+    {
+        sp::Timer timer{};
+        hist.record(timer);
+
+        sp::Clock clock{};
+        hist.record(clock.tick());
+
+        REQUIRE(hist.snapshot().count() == 2);
+
+        hist.reset();
+        REQUIRE(hist.snapshot().count() == 0);
+    }
+}
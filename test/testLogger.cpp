@@ -39,6 +39,35 @@ TEST_CASE("Messages")
         REQUIRE(critical.str() == "pi: 3.1416");
     }
 
+    SECTION("Long messages and copies")
+    {
+        std::string text(1000, 'x');
+
+        std::string head = text.substr(0, 200);
+        sp::Info small{"{}", head};
+        sp::Info large{"{}", text};
+        REQUIRE(small.str() == head);
+        REQUIRE(large.str() == text);
+
+        auto copy = large;
+        REQUIRE(copy.str() == text);
+        copy = small;
+        REQUIRE(copy.str() == head);
+
+        auto moved = std::move(large);
+        REQUIRE(moved.str() == text);
+        REQUIRE(moved.sourceLoc().line() == small.sourceLoc().line() + 1);
+
+        moved = std::move(copy);
+        REQUIRE(moved.str() == text.substr(0, 200));
+
+        sp::Info self{"{}", text};
+        auto & alias = self;
+        self         = alias;
+        self         = std::move(alias);
+        REQUIRE(self.str() == text);
+    }
+
     SECTION("Source location")
     {
         REQUIRE(sp::Info{}.sourceLoc().line() == __LINE__);
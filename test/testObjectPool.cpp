@@ -0,0 +1,145 @@
+#include "SPIRIT/Base/Utils/Memory/ObjectPool.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <new>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct alignas(32) Particle
+{
+    float position[3];
+    float velocity[3];
+    int id;
+};
+
+} // namespace
+
+TEST_CASE("ObjectPool")
+{
+    sp::ObjectPool<Particle> pool{};
+
+    SECTION("Slots are recycled")
+    {
+        REQUIRE(pool.getPool().getSlotSize() == 32);
+
+        std::vector<Particle *> particles{};
+        for (int i = 0; i < 5000; ++i)
+        {
+            particles.push_back(pool.create(Particle{{}, {}, i}));
+            REQUIRE(reinterpret_cast<std::uintptr_t>(particles.back()) % 32 == 0);
+        }
+
+        std::set<Particle *> unique{particles.begin(), particles.end()};
+        REQUIRE(unique.size() == particles.size());
+        for (int i = 0; i < 5000; ++i) REQUIRE(particles[i]->id == i);
+
+        std::size_t capacity = pool.getPool().capacity();
+        REQUIRE(capacity >= 5000);
+
+        for (Particle * particle : particles) pool.destroy(particle);
+        for (int i = 0; i < 5000; ++i) particles[i] = pool.create();
+
+        // Freed slots were reused
+        REQUIRE(pool.getPool().capacity() == capacity);
+        for (Particle * particle : particles) pool.destroy(particle);
+    }
+
+    SECTION("Constructor failure returns the slot")
+    {
+        sp::ObjectPool<std::string> strings{};
+        struct Throws
+        {
+            operator std::string() const { throw std::runtime_error{"no"}; }
+        };
+
+        auto * kept = strings.create("kept");
+        REQUIRE_THROWS_AS(strings.create(Throws{}), std::runtime_error);
+
+        auto * next = strings.create("next");
+        REQUIRE(*kept == "kept");
+        REQUIRE(*next == "next");
+        strings.destroy(kept);
+        strings.destroy(next);
+    }
+
+    SECTION("Threads")
+    {
+        // Producers allocate, the main thread frees everything
+        constexpr int nThreads = 4;
+        constexpr int nObjects = 20000;
+
+        std::vector<std::vector<Particle *>> created(nThreads);
+        std::vector<std::thread> threads{};
+        for (int t = 0; t < nThreads; ++t)
+        {
+            threads.emplace_back(
+                [&, t]()
+                {
+                    for (int i = 0; i < nObjects; ++i)
+                    {
+                        created[t].push_back(pool.create(Particle{{}, {}, i}));
+
+                        // Churn, freeing some of our own
+                        if (i % 3 == 0)
+                        {
+                            pool.destroy(created[t].back());
+                            created[t].pop_back();
+                        }
+                    }
+                }
+            );
+        }
+        for (auto & thread : threads) thread.join();
+
+        std::set<Particle *> unique{};
+        std::size_t total = 0;
+        for (auto & objects : created)
+        {
+            unique.insert(objects.begin(), objects.end());
+            total += objects.size();
+        }
+        REQUIRE(unique.size() == total);
+
+        // Slots cached by exited threads were returned
+        std::size_t capacity = pool.getPool().capacity();
+        for (Particle * particle : unique) pool.destroy(particle);
+        for (std::size_t i = 0; i < total; ++i) pool.create();
+        REQUIRE(pool.getPool().capacity() == capacity);
+    }
+}
+
+TEST_CASE("PoolAllocator")
+{
+    std::map<int, std::string, std::less<int>, sp::PoolAllocator<std::pair<const int, std::string>>>
+        map{};
+    for (int i = 0; i < 1000; ++i) map.emplace(i, std::to_string(i));
+    REQUIRE(map.size() == 1000);
+    REQUIRE(map.at(500) == "500");
+
+    std::list<int, sp::PoolAllocator<int>> list(100, 7);
+    REQUIRE(std::count(list.begin(), list.end(), 7) == 100);
+
+    // Arrays come from the heap
+    std::vector<int, sp::PoolAllocator<int>> vector(1000, 1);
+    REQUIRE(vector.size() == 1000);
+
+    sp::PoolAllocator<Particle> particles{};
+    REQUIRE_THROWS_AS(
+        particles.allocate(static_cast<std::size_t>(-1) / sizeof(Particle) + 1),
+        std::bad_array_new_length
+    );
+
+    REQUIRE(sp::PoolAllocator<int>{} == sp::PoolAllocator<double>{});
+    REQUIRE(sp::details::sizeClassPool(24, 8) == sp::details::sizeClassPool(32, 16));
+    REQUIRE(sp::details::sizeClassPool(257, 8) == nullptr);
+    REQUIRE(sp::details::sizeClassPool(16, 64) == nullptr);
+}
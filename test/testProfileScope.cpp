@@ -0,0 +1,189 @@
+#define SPIRIT_PROFILE SPIRIT_TRUE
+
+#include "SPIRIT/Base/Utils/Profiling/ProfileScope.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+std::size_t
+count(const std::string & str, const std::string & pattern)
+{
+    std::size_t n = 0;
+    for (auto pos = str.find(pattern); pos != std::string::npos;
+         pos      = str.find(pattern, pos + 1))
+        ++n;
+
+    return n;
+}
+
+std::string
+trace()
+{
+    std::ostringstream os{};
+    sp::writeChromeTrace(os);
+    return os.str();
+}
+
+void
+profiledFunction()
+{
+    SPIRIT_PROFILE_FUNCTION();
+    SPIRIT_PROFILE_SCOPE("inner \"quoted\"");
+}
+
+} // namespace
+
+TEST_CASE("ProfileScope")
+{
+    sp::clearTrace();
+
+    SECTION("Begin and end events")
+    {
+        profiledFunction();
+        REQUIRE(sp::traceEventCount() == 4);
+
+        std::string json = trace();
+        REQUIRE(json.starts_with("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+        REQUIRE(json.ends_with("]}\n"));
+
+        REQUIRE(count(json, "\"ph\":\"B\"") == 2);
+        REQUIRE(count(json, "\"ph\":\"E\"") == 2);
+        REQUIRE(count(json, "profiledFunction") == 4); // name and function of B, name of E
+        REQUIRE(count(json, "\"name\":\"inner \\\"quoted\\\"\"") == 2);
+        REQUIRE(count(json, "testProfileScope.cpp") == 2);
+
+        // the inner scope ends before the function
+        REQUIRE(json.find("\"inner") < json.rfind("profiledFunction"));
+    }
+
+    SECTION("Clear")
+    {
+        profiledFunction();
+        sp::clearTrace();
+        REQUIRE(sp::traceEventCount() == 0);
+        REQUIRE(count(trace(), "\"ph\"") == 0);
+    }
+
+    SECTION("Threads")
+    {
+        constexpr int nThreads = 4;
+        constexpr int nScopes  = 3000; // spans several chunks
+
+        std::vector<std::thread> threads{};
+        for (int t = 0; t < nThreads; ++t)
+            threads.emplace_back([]() {
+                for (int i = 0; i < nScopes; ++i)
+                    SPIRIT_PROFILE_SCOPE("work");
+            });
+
+        for (auto & thread : threads)
+            thread.join();
+
+        // events of exited threads are kept
+        REQUIRE(sp::traceEventCount() == 2 * nThreads * nScopes);
+        REQUIRE(count(trace(), "\"name\":\"work\"") == 2 * nThreads * nScopes);
+    }
+
+    SECTION("Capacity")
+    {
+        std::size_t capacity = sp::getTraceCapacity();
+        sp::Uint64 dropped   = sp::droppedTraceEventCount();
+
+        // the main thread's chunk is already in use, maybe partly consumed
+        sp::setTraceCapacity(4 * 1024);
+        for (int i = 0; i < 5000; ++i)
+            SPIRIT_PROFILE_SCOPE("work");
+
+        REQUIRE(sp::traceEventCount() <= 4 * 1024);
+        REQUIRE(sp::traceEventCount() > 3 * 1024);
+        REQUIRE(sp::traceEventCount() + (sp::droppedTraceEventCount() - dropped) == 10000);
+
+        // draining makes room
+        sp::clearTrace();
+        profiledFunction();
+        REQUIRE(sp::traceEventCount() == 4);
+
+        sp::setTraceCapacity(capacity);
+    }
+
+    SECTION("Drain while recording")
+    {
+        constexpr int nScopes = 20000;
+        std::atomic<bool> done{false};
+
+        std::thread thread{[&]() {
+            for (int i = 0; i < nScopes; ++i)
+            {
+                SPIRIT_PROFILE_SCOPE("work");
+                if (i % 100 == 0)
+                    std::this_thread::yield();
+            }
+            done = true;
+        }};
+
+        std::size_t nDrained = 0;
+        auto drain = [&]() {
+            std::ostringstream os{};
+            sp::drainChromeTrace(os);
+            nDrained += count(os.str(), "\"name\":\"work\"");
+        };
+
+        while (!done) drain();
+
+        thread.join();
+        drain();
+
+        REQUIRE(nDrained == 2 * nScopes);
+        REQUIRE(sp::traceEventCount() == 0);
+    }
+
+    SECTION("Exited threads release their buffers")
+    {
+        std::size_t capacity = sp::getTraceCapacity();
+        sp::Uint64 dropped   = sp::droppedTraceEventCount();
+        sp::setTraceCapacity(8 * 1024);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            std::thread{[]() { SPIRIT_PROFILE_SCOPE("short lived"); }}.join();
+
+            std::ostringstream os{};
+            sp::drainChromeTrace(os);
+            REQUIRE(count(os.str(), "short lived") == 2);
+        }
+
+        // the exited threads' chunks were freed
+        for (int i = 0; i < 3000; ++i)
+            SPIRIT_PROFILE_SCOPE("work");
+
+        REQUIRE(sp::droppedTraceEventCount() == dropped);
+        REQUIRE(sp::traceEventCount() == 6000);
+
+        sp::setTraceCapacity(capacity);
+    }
+
+    SECTION("File")
+    {
+        profiledFunction();
+
+        FILE * file = std::tmpfile();
+        REQUIRE(file);
+        REQUIRE(sp::writeChromeTrace(file));
+
+        std::string json(static_cast<std::size_t>(std::ftell(file)), '\0');
+        std::rewind(file);
+        REQUIRE(std::fread(json.data(), 1, json.size(), file) == json.size());
+        std::fclose(file);
+
+        REQUIRE(json == trace());
+    }
+}
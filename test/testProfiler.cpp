@@ -0,0 +1,139 @@
+#include "SPIRIT/Base/Utils/Profiling/Profiler.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+void
+leaf()
+{
+    SPIRIT_AGGREGATE_SCOPE("leaf");
+    std::this_thread::sleep_for(1ms);
+}
+
+void
+frame()
+{
+    SPIRIT_AGGREGATE_SCOPE("frame");
+    leaf();
+    leaf();
+}
+
+} // namespace
+
+TEST_CASE("Profiler")
+{
+    sp::resetProfile();
+
+    SECTION("Call tree")
+    {
+        for (int i = 0; i < 3; ++i)
+            frame();
+
+        sp::ProfileNode root = sp::collectProfile();
+        REQUIRE(root.children.size() == 1);
+
+        const sp::ProfileNode * f = root.find("frame");
+        REQUIRE(f);
+        REQUIRE(f->calls == 3);
+        REQUIRE(root.inclusive == f->inclusive);
+
+        const sp::ProfileNode * l = f->find("leaf");
+        REQUIRE(l);
+        REQUIRE(l->calls == 6);
+        REQUIRE(l->children.empty());
+
+        REQUIRE(l->min >= 1ms);
+        REQUIRE(l->min <= l->max);
+        REQUIRE(l->inclusive >= 6ms);
+        REQUIRE(l->exclusive == l->inclusive);
+
+        REQUIRE(f->exclusive == f->inclusive - l->inclusive);
+        REQUIRE(f->exclusive < f->inclusive);
+    }
+
+    SECTION("Threads are merged")
+    {
+        std::vector<std::thread> threads{};
+        for (int t = 0; t < 3; ++t)
+            threads.emplace_back([]() { frame(); });
+
+        for (auto & thread : threads)
+            thread.join();
+
+        sp::ProfileNode root = sp::collectProfile();
+        REQUIRE(root.children.size() == 1);
+        REQUIRE(root.find("frame")->calls == 3);
+        REQUIRE(root.find("frame")->find("leaf")->calls == 6);
+    }
+
+    SECTION("Exited threads")
+    {
+        // the threads take over each other's profiles
+        for (int t = 0; t < 3; ++t)
+            std::thread{[]() { frame(); }}.join();
+
+        sp::ProfileNode root = sp::collectProfile(true);
+        REQUIRE(root.children.size() == 1);
+        REQUIRE(root.find("frame")->calls == 3);
+        REQUIRE(root.find("frame")->find("leaf")->calls == 6);
+
+        // their profiles were removed with their statistics
+        REQUIRE(sp::collectProfile().children.empty());
+
+        std::thread{[]() { leaf(); }}.join();
+        root = sp::collectProfile();
+        REQUIRE(root.children.size() == 1);
+        REQUIRE(root.find("leaf")->calls == 1);
+    }
+
+    SECTION("Reset")
+    {
+        frame();
+        REQUIRE(sp::collectProfile(true).find("frame")->calls == 1);
+
+        // uncalled scopes are pruned
+        REQUIRE(sp::collectProfile().children.empty());
+
+        frame();
+        REQUIRE(sp::collectProfile().find("frame")->calls == 1);
+
+        sp::resetProfile();
+        REQUIRE(sp::collectProfile().children.empty());
+    }
+
+    SECTION("Open scopes")
+    {
+        SPIRIT_AGGREGATE_SCOPE("open");
+        leaf();
+
+        sp::ProfileNode root = sp::collectProfile();
+        REQUIRE(root.find("open"));
+        REQUIRE(root.find("open")->calls == 0);
+        REQUIRE(root.find("open")->find("leaf")->calls == 1);
+    }
+
+    SECTION("Report")
+    {
+        frame();
+        std::string report = sp::formatProfile(sp::collectProfile(), false);
+
+        REQUIRE(report.find("\x1b") == std::string::npos);
+        REQUIRE(report.find("\n") != std::string::npos);
+        REQUIRE(report.find("  frame") != std::string::npos);
+        REQUIRE(report.find("    leaf") != std::string::npos);
+        REQUIRE(report.find("100.0%") != std::string::npos);
+
+        REQUIRE(sp::formatProfile(sp::collectProfile(), true).find("\x1b[") != std::string::npos);
+
+        sp::logProfile();
+        REQUIRE(sp::logProfileEvery(0ns));
+        REQUIRE_FALSE(sp::logProfileEvery(1h));
+    }
+}
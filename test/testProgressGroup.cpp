@@ -0,0 +1,123 @@
+#include "SPIRIT/Base/Logging/ProgressGroup.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+std::string
+readAll(FILE * f)
+{
+    fflush(f);
+    fseek(f, 0, SEEK_END);
+    std::string content(ftell(f), '\0');
+    fseek(f, 0, SEEK_SET);
+    fread(content.data(), 1, content.size(), f);
+    return content;
+}
+
+TEST_CASE("Progress Group")
+{
+    FILE * f = tmpfile();
+    REQUIRE(f != nullptr);
+
+    SECTION("Concurrent updates")
+    {
+        sp::AnsiFileStream out{f, sp::ansiMode::always};
+        {
+            sp::ProgressGroup progress{out, std::chrono::milliseconds{1}, 10};
+
+            std::vector<std::thread> workers{};
+            for (int i = 0; i < 4; ++i)
+            {
+                sp::ProgressBar bar = progress.addBar(sp::format("task {}", i), 1000);
+                workers.emplace_back(
+                    [bar]() mutable
+                    {
+                        for (int _ = 0; _ < 1000; ++_) bar.advance();
+                    }
+                );
+            }
+
+            for (auto & worker : workers) worker.join();
+        }
+        out->flush();
+
+        std::string content = readAll(f);
+        REQUIRE(content.find("100% 1000/1000") != std::string::npos);
+        REQUIRE(content.find("\x1b[") != std::string::npos);
+    }
+
+    SECTION("Without ansi, only the final state is printed")
+    {
+        sp::AnsiFileStream out{f, sp::ansiMode::never};
+        {
+            sp::ProgressGroup progress{out, std::chrono::milliseconds{1}, 4};
+            sp::ProgressBar a = progress.addBar("a", 4);
+            sp::ProgressBar bc = progress.addBar("bc", 10);
+
+            a.set(2);
+            bc.advance(10);
+            REQUIRE(bc.isDone());
+        }
+        out->flush();
+
+        REQUIRE(
+            readAll(f)
+            == "a  [##--]  50% 2/4  \n"
+               "bc [####] 100% 10/10\n"
+        );
+    }
+
+    SECTION("Attached loggers")
+    {
+        sp::AnsiFileStream out{f, sp::ansiMode::always};
+        auto sink = std::make_shared<sp::AnsiStreamSink_mt<std::stringstream>>(false);
+        auto logger = std::make_shared<sp::Logger>("progress", sink);
+        logger->set_pattern("%v");
+
+        spdlog::sink_ptr logSink{};
+        {
+            sp::ProgressGroup progress{out, std::chrono::milliseconds{1}, 4};
+            progress.addBar("a", 4);
+
+            progress.attach(logger);
+            progress.attach(logger); // no effect
+            REQUIRE(logger->sinks().size() == 1);
+            REQUIRE(logger->sinks().front() != sink);
+            logSink = logger->sinks().front();
+
+            *logger << sp::Info{"logged"};
+            REQUIRE(sink->stream().str() == "logged\n");
+        }
+
+        // the sink stays in place, records pass through once detached
+        REQUIRE(logger->sinks().size() == 1);
+        REQUIRE(logger->sinks().front() == logSink);
+        *logger << sp::Info{"detached"};
+        REQUIRE(sink->stream().str() == "logged\ndetached\n");
+
+        // attaching again reuses it, even while other threads log
+        std::atomic<bool> done{false};
+        std::thread logging{[&]() {
+            while (!done) *logger << sp::Info{"x"};
+        }};
+
+        for (int i = 0; i < 20; ++i)
+        {
+            sp::ProgressGroup progress{out, std::chrono::milliseconds{1}, 4};
+            progress.addBar("b", 1);
+            progress.attach(logger);
+            progress.detach(logger);
+            progress.attach(logger);
+        }
+
+        done = true;
+        logging.join();
+        REQUIRE(logger->sinks().front() == logSink);
+    }
+
+    fclose(f);
+}
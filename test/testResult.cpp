@@ -0,0 +1,150 @@
+#include "SPIRIT/Base/Error/Result.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+enum parseError : sp::Int32
+{
+    empty     = 1,
+    notADigit = 2
+};
+
+sp::Result<int>
+parseDigit(std::string_view str)
+{
+    if (str.empty())
+        return sp::Failure{parseError::empty};
+
+    if (str[0] < '0' || str[0] > '9')
+        return sp::Failure{parseError::notADigit, "'{}' is not a digit", str[0]};
+
+    return str[0] - '0';
+}
+
+sp::Result<void>
+validate(int value)
+{
+    if (value > 5)
+        return sp::Failure{3, "too large"};
+
+    return {};
+}
+
+struct Counted
+{
+    friend std::ostream &
+    operator<<(std::ostream & os, const Counted & c)
+    {
+        ++*c.nFormats;
+        return os << "counted";
+    }
+
+    std::shared_ptr<int> nFormats = std::make_shared<int>(0);
+};
+
+} // namespace
+
+
+TEST_CASE("Result")
+{
+    SECTION("Values")
+    {
+        sp::Result<int> res = parseDigit("7");
+        REQUIRE(res);
+        REQUIRE(res.hasValue());
+        REQUIRE(res.value() == 7);
+        REQUIRE(res.valueOr(0) == 7);
+
+        sp::Result<std::unique_ptr<int>> ptr{std::make_unique<int>(3)};
+        std::unique_ptr<int> moved = std::move(ptr).value();
+        REQUIRE(*moved == 3);
+
+        REQUIRE(validate(1));
+        REQUIRE_NOTHROW(validate(1).value());
+    }
+
+    SECTION("Failures")
+    {
+        sp::Result<int> res = parseDigit("");
+        REQUIRE_FALSE(res);
+        REQUIRE(res.failure().code() == parseError::empty);
+        REQUIRE_FALSE(res.failure().hasMessage());
+        REQUIRE(res.valueOr(-1) == -1);
+
+        res = parseDigit("x");
+        REQUIRE(res.failure().code() == parseError::notADigit);
+        REQUIRE(res.failure().message() == "'x' is not a digit");
+
+        sp::Result<void> tooLarge = validate(6);
+        REQUIRE_FALSE(tooLarge);
+        REQUIRE(tooLarge.failure().message() == "too large");
+
+        std::stringstream ss{};
+        ss << tooLarge.failure();
+        REQUIRE(ss.str() == "Failure 3: too large");
+    }
+
+    SECTION("Messages are formatted lazily")
+    {
+        Counted counted{};
+        sp::Result<int> res = sp::Failure{4, "{}", counted};
+        sp::Result<int> copy = res;
+
+        REQUIRE(*counted.nFormats == 0);
+        REQUIRE(copy.failure().message() == "counted");
+        REQUIRE(*counted.nFormats == 1);
+    }
+
+    SECTION("Temporary strings are copied")
+    {
+        auto make = []()
+        {
+            std::string text{"built at runtime {"};
+            char buffer[32] = "from a buffer";
+            std::string format{"{} and {}"};
+
+            // const arrays are not necessarily literals
+            const char constBuffer[] = "const {}";
+            struct Token
+            {
+                char text[8];
+            };
+            const Token token{"token"};
+            const Token & tokenRef = token;
+
+            return std::vector<sp::Failure>{
+                sp::Failure{1, text.c_str()},
+                sp::Failure{2, text},
+                sp::Failure{3, buffer},
+                sp::Failure{4, format, text.c_str(), std::string_view{buffer}},
+                sp::Failure{5, tokenRef.text},
+                sp::Failure{6, constBuffer, tokenRef.text},
+            };
+        };
+
+        std::vector<sp::Failure> failures = make();
+        REQUIRE(failures[0].message() == "built at runtime {");
+        REQUIRE(failures[1].message() == "built at runtime {");
+        REQUIRE(failures[2].message() == "from a buffer");
+        REQUIRE(failures[3].message() == "built at runtime { and from a buffer");
+        REQUIRE(failures[4].message() == "token");
+        REQUIRE(failures[5].message() == "const token");
+    }
+
+    SECTION("Escalation")
+    {
+        sp::Result<int> res = parseDigit("x");
+
+        REQUIRE_THROWS_AS(res.value(), sp::SpiritError);
+        REQUIRE_THROWS_AS(validate(6).value(), sp::SpiritError);
+
+        sp::SpiritError error = res.failure().toError();
+        REQUIRE(error.message() == "Failure 2: 'x' is not a digit");
+    }
+}
@@ -0,0 +1,240 @@
+#include "SPIRIT/Base/Utils/Concurrency/Ring.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("SpscRing")
+{
+    SECTION("Queue")
+    {
+        sp::SpscRing<std::string> ring{5};
+        REQUIRE(ring.capacity() == 8);
+        REQUIRE(ring.empty());
+
+        std::string out{};
+        REQUIRE_FALSE(ring.tryPop(out));
+
+        // Wraps around several times
+        for (int lap = 0; lap < 3; ++lap)
+        {
+            for (int i = 0; i < 8; ++i) REQUIRE(ring.tryPush(std::to_string(i)));
+            REQUIRE_FALSE(ring.tryPush("full"));
+            REQUIRE(ring.size() == 8);
+
+            for (int i = 0; i < 8; ++i)
+            {
+                REQUIRE(ring.tryPop(out));
+                REQUIRE(out == std::to_string(i));
+            }
+            REQUIRE(ring.empty());
+        }
+    }
+
+    SECTION("Batches")
+    {
+        sp::SpscRing<int> ring{16};
+        std::vector<int> values(20);
+        std::iota(values.begin(), values.end(), 0);
+
+        auto rest = ring.tryPushBatch(values.begin(), values.end());
+        REQUIRE(rest == values.begin() + 16);
+
+        std::vector<int> popped{};
+        REQUIRE(ring.tryPopBatch(std::back_inserter(popped), 10) == 10);
+        REQUIRE(ring.tryPushBatch(rest, values.end()) == values.end());
+        REQUIRE(ring.tryPopBatch(std::back_inserter(popped), 100) == 10);
+        REQUIRE(popped == values);
+    }
+
+    SECTION("Remaining elements are destroyed")
+    {
+        auto shared = std::make_shared<int>(0);
+        {
+            sp::SpscRing<std::shared_ptr<int>> ring{4};
+            for (int i = 0; i < 3; ++i) ring.tryPush(shared);
+            std::shared_ptr<int> out{};
+            ring.tryPop(out);
+        }
+        REQUIRE(shared.use_count() == 1);
+    }
+}
+
+TEST_CASE("SpscRing threads")
+{
+    constexpr sp::Uint64 count = 200'000;
+
+    SECTION("Spinning")
+    {
+        sp::SpscRing<sp::Uint64> ring{64};
+        std::thread producer{[&]()
+                             {
+                                 for (sp::Uint64 i = 0; i < count;)
+                                 {
+                                     if (ring.tryPush(i))
+                                         ++i;
+                                     else
+                                         std::this_thread::yield();
+                                 }
+                             }};
+
+        sp::Uint64 expected = 0;
+        std::vector<sp::Uint64> batch{};
+        while (expected < count)
+        {
+            batch.clear();
+            if (ring.tryPopBatch(std::back_inserter(batch), 16) == 0)
+                std::this_thread::yield();
+
+            for (sp::Uint64 value : batch)
+            {
+                if (value != expected)
+                    FAIL("expected " << expected << " got " << value);
+                ++expected;
+            }
+        }
+        producer.join();
+    }
+
+    SECTION("Blocking")
+    {
+        sp::SpscRing<sp::Uint64, true> ring{8};
+        std::thread producer{[&]()
+                             {
+                                 for (sp::Uint64 i = 0; i < count; ++i)
+                                     ring.push(i);
+                             }};
+
+        bool ordered = true;
+        for (sp::Uint64 i = 0; i < count; ++i) ordered &= ring.pop() == i;
+        producer.join();
+        REQUIRE(ordered);
+    }
+}
+
+TEST_CASE("MpscRing")
+{
+    SECTION("Queue")
+    {
+        sp::MpscRing<std::unique_ptr<int>> ring{4};
+        for (int i = 0; i < 4; ++i) REQUIRE(ring.tryPush(std::make_unique<int>(i)));
+
+        auto extra = std::make_unique<int>(4);
+        REQUIRE_FALSE(ring.tryPush(std::move(extra)));
+        REQUIRE(extra != nullptr); // not consumed when full
+
+        std::unique_ptr<int> out{};
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(ring.tryPop(out));
+            REQUIRE(*out == i);
+        }
+        REQUIRE_FALSE(ring.tryPop(out));
+
+        // Throwing copies are made before claiming a slot
+        sp::MpscRing<std::string> strings{2};
+        std::string text = "copied";
+        REQUIRE(strings.tryPush(text));
+        REQUIRE(strings.size() == 1);
+    }
+
+    SECTION("Batches")
+    {
+        sp::MpscRing<int> ring{8};
+        std::vector<int> values{1, 2, 3, 4, 5, 6};
+        REQUIRE(ring.tryPushBatch(values.begin(), values.end()) == values.end());
+        REQUIRE(ring.tryPushBatch(values.begin(), values.end()) == values.begin() + 2);
+
+        std::vector<int> popped{};
+        REQUIRE(ring.tryPopBatch(std::back_inserter(popped), 100) == 8);
+        REQUIRE(popped == std::vector<int>{1, 2, 3, 4, 5, 6, 1, 2});
+    }
+}
+
+TEST_CASE("MpscRing threads")
+{
+    static constexpr int nProducers = 4;
+    static constexpr sp::Uint64 perProducer = 50'000;
+
+    // Each value holds its producer and sequence number
+    auto check = [](auto & popOne)
+    {
+        std::vector<sp::Uint64> next(nProducers, 0);
+        bool ordered = true;
+        for (sp::Uint64 i = 0; i < nProducers * perProducer; ++i)
+        {
+            sp::Uint64 value = popOne();
+            auto producer    = value >> 32;
+            ordered &= (value & 0xFFFFFFFF) == next[producer]++;
+        }
+        return ordered;
+    };
+
+    SECTION("Spinning")
+    {
+        sp::MpscRing<sp::Uint64> ring{64};
+        std::vector<std::thread> producers{};
+        for (sp::Uint64 p = 0; p < nProducers; ++p)
+        {
+            producers.emplace_back(
+                [&ring, p]()
+                {
+                    std::vector<sp::Uint64> batch{};
+                    for (sp::Uint64 i = 0; i < perProducer;)
+                    {
+                        // Alternate between single pushes and batches
+                        if (i % 2 == 0)
+                        {
+                            if (ring.tryPush(p << 32 | i))
+                                ++i;
+                            else
+                                std::this_thread::yield();
+                            continue;
+                        }
+
+                        batch.clear();
+                        for (sp::Uint64 j = i; j < std::min(i + 5, perProducer); ++j)
+                            batch.push_back(p << 32 | j);
+                        auto rest = ring.tryPushBatch(batch.begin(), batch.end());
+                        i += rest - batch.begin();
+                        if (rest == batch.begin())
+                            std::this_thread::yield();
+                    }
+                }
+            );
+        }
+
+        auto popOne = [&ring]()
+        {
+            sp::Uint64 value = 0;
+            while (!ring.tryPop(value)) std::this_thread::yield();
+            return value;
+        };
+
+        REQUIRE(check(popOne));
+        for (auto & producer : producers) producer.join();
+        REQUIRE(ring.empty());
+    }
+
+    SECTION("Blocking")
+    {
+        sp::MpscRing<sp::Uint64, true> ring{16};
+        std::vector<std::thread> producers{};
+        for (sp::Uint64 p = 0; p < nProducers; ++p)
+        {
+            producers.emplace_back(
+                [&ring, p]()
+                {
+                    for (sp::Uint64 i = 0; i < perProducer; ++i) ring.push(p << 32 | i);
+                }
+            );
+        }
+
+        auto popOne = [&ring]() { return ring.pop(); };
+        REQUIRE(check(popOne));
+        for (auto & producer : producers) producer.join();
+    }
+}
@@ -0,0 +1,94 @@
+#include "SPIRIT/Base/Utils/Time/Clock.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using ns = std::chrono::nanoseconds;
+
+TEST_CASE("RollingStats")
+{
+    sp::RollingStats stats{4};
+
+    SECTION("Empty")
+    {
+        REQUIRE(stats.size() == 0);
+        REQUIRE(stats.mean() == ns{0});
+        REQUIRE(stats.min() == ns{0});
+        REQUIRE(stats.p99() == ns{0});
+    }
+
+    SECTION("Window")
+    {
+        for (int v : {10, 20, 30, 40}) stats.push(ns{v});
+
+        REQUIRE(stats.size() == 4);
+        REQUIRE(stats.last() == ns{40});
+        REQUIRE(stats.mean() == ns{25});
+        REQUIRE(stats.min() == ns{10});
+        REQUIRE(stats.max() == ns{40});
+        REQUIRE(stats.stddev() == ns{11}); // sqrt(125)
+
+        // 10 leaves the window
+        stats.push(ns{50});
+        REQUIRE(stats.size() == 4);
+        REQUIRE(stats.mean() == ns{35});
+        REQUIRE(stats.min() == ns{20});
+
+        // so does 50, eventually
+        for (int v : {1, 2, 3, 4}) stats.push(ns{v});
+        REQUIRE(stats.max() == ns{4});
+        REQUIRE(stats.min() == ns{1});
+
+        stats.setWindowSize(2);
+        REQUIRE(stats.windowSize() == 2);
+        REQUIRE(stats.size() == 0);
+    }
+
+    SECTION("Percentiles")
+    {
+        stats.setWindowSize(1000);
+
+        std::vector<sp::Int64> values{};
+        std::mt19937 gen{42};
+        std::uniform_int_distribution<sp::Int64> dist{1'000'000, 50'000'000};
+        for (int i = 0; i < 5000; ++i)
+        {
+            values.push_back(dist(gen));
+            stats.push(ns{values.back()});
+        }
+
+        std::vector<sp::Int64> window{values.end() - 1000, values.end()};
+        std::sort(window.begin(), window.end());
+
+        auto exact = [&window](double p)
+        { return window[static_cast<std::size_t>(p / 100 * window.size()) - 1]; };
+
+        for (double p : {50.0, 95.0, 99.0})
+        {
+            double approx = static_cast<double>(stats.percentile(p).count());
+            REQUIRE(std::abs(approx - exact(p)) / exact(p) < 0.04);
+        }
+
+        REQUIRE(stats.percentile(100) == stats.max());
+        REQUIRE(stats.percentile(0) == stats.min());
+
+        double mean = 0;
+        for (sp::Int64 v : window) mean += v;
+        mean /= window.size();
+        REQUIRE(std::abs(stats.mean().count() - mean) < 1);
+    }
+}
+
+TEST_CASE("Clock statistics")
+{
+    sp::Clock clock{};
+    clock.setStatsWindow(5);
+
+    for (int i = 0; i < 8; ++i) clock.tick();
+
+    REQUIRE(clock.getStats().size() == 5);
+    REQUIRE(clock.getAverageTick() == clock.getStats().mean());
+    REQUIRE(clock.getStats().min() <= clock.getStats().max());
+}
@@ -0,0 +1,131 @@
+#include "SPIRIT/Base/Logging/ScreenRenderer.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <sstream>
+
+typedef sp::AnsiStreamWrapper<std::stringstream> Out;
+
+std::string
+takeOutput(Out & out)
+{
+    std::string str = out->str();
+    out->str("");
+    return str;
+}
+
+TEST_CASE("Screen Renderer")
+{
+    Out out{true};
+
+    SECTION("Back buffer")
+    {
+        sp::ScreenRenderer<Out> screen{out, 2, 4, 0};
+
+        REQUIRE(screen.print(0, 2, "abc") == 2);
+        REQUIRE(screen.print(1, -1, "xy", sp::red) == 1);
+        screen.put(5, 5, sp::ScreenCell{'z'}); // ignored
+
+        REQUIRE(screen.cell(0, 2).ch == 'a');
+        REQUIRE(screen.cell(0, 3).ch == 'b');
+        REQUIRE(screen.cell(1, 0).ch == 'y');
+        REQUIRE(screen.cell(1, 0).fg.getColor() == sp::red.getColor());
+
+        screen.clear();
+        REQUIRE(screen.cell(0, 2) == sp::ScreenCell{});
+    }
+
+    SECTION("Absolute region")
+    {
+        sp::ScreenRenderer<Out> screen{out, 2, 8, 0};
+        screen.anchorAt(3, 5);
+
+        screen.print(0, 0, "status");
+        screen.print(1, 0, "ok", sp::green);
+        REQUIRE(screen.present());
+
+        std::stringstream expected{};
+        expected << sp::MoveCursorTo{3, 5} << "status  " << sp::MoveCursorTo{4, 5}
+                 << sp::green << "ok" << sp::defaultFg << "      " << std::flush;
+        REQUIRE(takeOutput(out) == expected.str());
+
+        SECTION("Unchanged frames output nothing")
+        {
+            screen.presentNow();
+            REQUIRE(takeOutput(out) == "");
+        }
+
+        SECTION("Only changed cells are output")
+        {
+            screen.print(0, 0, "Status");
+            screen.print(1, 0, "ko", sp::green);
+            screen.presentNow();
+
+            expected.str("");
+            expected << sp::MoveCursorTo{3, 5} << "S" << sp::MoveCursorTo{4, 5}
+                     << sp::green << "ko" << sp::reset;
+            REQUIRE(takeOutput(out) == expected.str());
+        }
+
+        SECTION("Short gaps are rewritten, long ones skipped")
+        {
+            screen.print(0, 3, "T");
+            screen.print(0, 7, "!");
+            screen.presentNow();
+
+            expected.str("");
+            expected << sp::MoveCursorTo{3, 8} << "T" << "us " << "!";
+            REQUIRE(takeOutput(out) == expected.str());
+
+            screen.print(0, 0, "S");
+            screen.print(0, 7, "?");
+            screen.presentNow();
+
+            expected.str("");
+            expected << sp::MoveCursorTo{3, 5} << "S" << sp::CursorRight{6} << "?";
+            REQUIRE(takeOutput(out) == expected.str());
+        }
+    }
+
+    SECTION("Inline region")
+    {
+        sp::ScreenRenderer<Out> screen{out, 2, 3, 0};
+
+        screen.print(0, 0, "abc");
+        screen.print(1, 0, "def");
+        screen.presentNow();
+
+        std::stringstream expected{};
+        expected << sp::CarriageRet{} << "abc" << sp::EraseCursorToEndLine{}
+                 << sp::CarriageRet{} << "\n"
+                 << "def" << sp::EraseCursorToEndLine{} << sp::CarriageRet{};
+        REQUIRE(takeOutput(out) == expected.str());
+
+        screen.print(0, 1, "B");
+        screen.presentNow();
+
+        expected.str("");
+        expected << sp::CursorUp{1} << sp::CursorRight{1} << "B"
+                 << sp::CursorDown{1} << sp::CarriageRet{};
+        REQUIRE(takeOutput(out) == expected.str());
+
+        screen.erase();
+        expected.str("");
+        expected << sp::CursorUp{1} << sp::EraseCursorToEndScreen{};
+        REQUIRE(takeOutput(out) == expected.str());
+    }
+
+    SECTION("Frame rate")
+    {
+        sp::ScreenRenderer<Out> screen{out, 1, 1, 1};
+
+        // First frame is always drawn
+        REQUIRE(screen.present());
+
+        screen.print(0, 0, "a");
+        REQUIRE_FALSE(screen.present());
+        REQUIRE(takeOutput(out).find('a') == std::string::npos);
+
+        screen.invalidate();
+        REQUIRE(screen.present());
+    }
+}
@@ -0,0 +1,111 @@
+#include "SPIRIT/Base/Utils/Containers/SoA.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct Vec3
+{
+    float x, y, z;
+};
+
+template <class Span>
+bool
+isAligned(Span span)
+{
+    return reinterpret_cast<std::uintptr_t>(span.data()) % 64 == 0;
+}
+
+} // namespace
+
+TEST_CASE("SoA")
+{
+    SECTION("Columns")
+    {
+        sp::SoA<Vec3, Vec3, float> bodies{};
+        for (int i = 0; i < 100; ++i)
+            bodies.emplace_back(Vec3{float(i), 0, 0}, Vec3{1, 2, 3}, 1.f / (i + 1));
+
+        REQUIRE(bodies.size() == 100);
+        REQUIRE(bodies.capacity() >= 100);
+
+        auto positions  = bodies.column<0>();
+        auto velocities = bodies.column<1>();
+        REQUIRE(positions.size() == 100);
+        REQUIRE(isAligned(positions));
+        REQUIRE(isAligned(velocities));
+        REQUIRE(isAligned(bodies.column<2>()));
+
+        for (std::size_t i = 0; i < positions.size(); ++i)
+            positions[i].x += velocities[i].x * 2;
+
+        REQUIRE(bodies.get<0>(10).x == 12);
+
+        // Rows are proxies
+        auto [position, velocity, mass] = bodies[10];
+        position.y = 5;
+        REQUIRE(bodies.get<0>(10).y == 5);
+        REQUIRE(mass == 1.f / 11);
+
+        for (auto [p, v, m] : bodies) m = 0;
+        auto masses = bodies.column<2>();
+        REQUIRE(std::all_of(masses.begin(), masses.end(), [](float m) { return m == 0; }));
+    }
+
+    SECTION("Erase")
+    {
+        sp::SoA<int, std::string> rows{};
+        for (int i = 0; i < 6; ++i) rows.emplace_back(i, std::to_string(i));
+
+        auto next = rows.erase(rows.begin() + 1);
+        REQUIRE(std::get<0>(*next) == 2);
+        REQUIRE(rows.size() == 5);
+
+        rows.eraseUnordered(0);
+        REQUIRE(rows.size() == 4);
+        REQUIRE(rows.get<0>(0) == 5);
+        REQUIRE(rows.get<1>(0) == "5");
+
+        std::vector<int> ints(rows.column<0>().begin(), rows.column<0>().end());
+        REQUIRE(ints == std::vector<int>{5, 2, 3, 4});
+        REQUIRE(rows.get<1>(3) == "4");
+
+        rows.pop_back();
+        auto [lastInt, lastString] = rows.back();
+        REQUIRE(lastInt == 3);
+        REQUIRE(lastString == "3");
+
+    }
+
+    SECTION("Copies and growth")
+    {
+        sp::SoA<std::unique_ptr<int>, std::string> owners{};
+        for (int i = 0; i < 50; ++i)
+            owners.emplace_back(std::make_unique<int>(i), std::string(40, 'a' + i % 26));
+
+        // Pushing one of our own rows while growing
+        sp::SoA<std::string> strings{};
+        strings.push_back({"first"});
+        for (int i = 0; i < 20; ++i) strings.emplace_back(strings.get<0>(0));
+        REQUIRE(strings.get<0>(20) == "first");
+
+        sp::SoA<std::string> copy{strings};
+        REQUIRE(copy.size() == 21);
+        REQUIRE(copy.get<0>(20) == "first");
+
+        sp::SoA<std::unique_ptr<int>, std::string> moved{std::move(owners)};
+        REQUIRE(owners.empty());
+        REQUIRE(*moved.get<0>(49) == 49);
+        REQUIRE(moved.get<1>(49) == std::string(40, 'x'));
+
+        moved.clear();
+        REQUIRE(moved.empty());
+        REQUIRE(moved.capacity() >= 50);
+    }
+}
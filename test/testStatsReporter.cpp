@@ -0,0 +1,102 @@
+#include "SPIRIT/Base/Logging/StatsReporter.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Counter")
+{
+    sp::Counter counter{4};
+    REQUIRE(counter.read() == 0);
+
+    std::vector<std::thread> threads{};
+    for (int t = 0; t < 8; ++t)
+        threads.emplace_back([&counter]() {
+            for (int i = 0; i < 10'000; ++i)
+                counter.add();
+        });
+
+    for (auto & thread : threads)
+        thread.join();
+
+    counter.add(5);
+    REQUIRE(counter.read() == 80'005);
+}
+
+TEST_CASE("StatsReporter")
+{
+    auto sink = std::make_shared<sp::AnsiStreamSink_mt<std::stringstream>>(false);
+    auto logger = std::make_shared<sp::Logger>("Stats", sink);
+    logger->set_pattern("%v");
+
+    sp::Counter requests{};
+    sp::Histogram latency{};
+    double queue = 3;
+
+    SECTION("Record")
+    {
+        sp::StatsReporter stats{logger, 1h};
+
+        requests.add(100); // before registration, not reported
+        stats.addCounter("requests", requests);
+        stats.addGauge("queue", [&queue]() { return queue; });
+        stats.addHistogram("latency", latency);
+
+        requests.add(20);
+        latency.record(1ms);
+        latency.record(3ms);
+
+        std::string record = stats.collect();
+        REQUIRE(record.starts_with("Stats over "));
+        REQUIRE(record.find(": requests 20 (") != std::string::npos);
+        REQUIRE(record.find("/s), queue 3, latency n=2 p50 ") != std::string::npos);
+        REQUIRE(record.ends_with("max 3.00ms"));
+
+        // counters and histograms restart with each record
+        queue = 1.5;
+        record = stats.collect();
+        REQUIRE(record.find("requests 0 (0.00/s), queue 1.5, latency n=0") != std::string::npos);
+
+        stats.remove("queue");
+        REQUIRE(stats.collect().find("queue") == std::string::npos);
+
+        stats.reportNow();
+        REQUIRE(sink->stream().str().starts_with("Stats over "));
+    }
+
+    SECTION("Background thread")
+    {
+        sp::StatsReporter stats{logger, 20ms};
+        stats.addCounter("requests", requests);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            requests.add();
+            std::this_thread::sleep_for(10ms);
+        }
+        stats.stop();
+
+        std::string out = sink->stream().str();
+        std::size_t nRecords = 0;
+        for (auto pos = out.find("Stats over"); pos != std::string::npos;
+             pos      = out.find("Stats over", pos + 1))
+            ++nRecords;
+
+        REQUIRE(nRecords >= 2);
+        REQUIRE(nRecords <= 6);
+    }
+
+    SECTION("Stopping does not wait for the period")
+    {
+        auto start = std::chrono::steady_clock::now();
+        {
+            sp::StatsReporter stats{logger, 1h};
+        }
+        REQUIRE(std::chrono::steady_clock::now() - start < 1s);
+        REQUIRE(sink->stream().str().empty());
+    }
+}
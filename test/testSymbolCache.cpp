@@ -0,0 +1,117 @@
+#include "SPIRIT/Base/Error/Error.hpp"
+#include "SPIRIT/Base/Error/details/SymbolCache.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+std::atomic<int> nResolved{0};
+
+std::string
+resolve(const void * address)
+{
+    ++nResolved;
+    return std::to_string(reinterpret_cast<std::uintptr_t>(address));
+}
+
+const void *
+addr(std::uintptr_t i)
+{
+    return reinterpret_cast<const void *>(i);
+}
+
+} // namespace
+
+
+TEST_CASE("SymbolCache")
+{
+    nResolved = 0;
+
+    SECTION("Hits")
+    {
+        sp::details::SymbolCache cache{4};
+
+        REQUIRE(cache.get(addr(1), &resolve) == "1");
+        REQUIRE(cache.get(addr(1), &resolve) == "1");
+        REQUIRE(cache.get(addr(2), &resolve) == "2");
+
+        REQUIRE(nResolved == 2);
+        REQUIRE(cache.size() == 2);
+    }
+
+    SECTION("Least recently used entries are evicted")
+    {
+        sp::details::SymbolCache cache{2};
+
+        cache.get(addr(1), &resolve);
+        cache.get(addr(2), &resolve);
+        cache.get(addr(1), &resolve); // 2 is now the oldest
+        cache.get(addr(3), &resolve);
+        REQUIRE(cache.size() == 2);
+        REQUIRE(nResolved == 3);
+
+        cache.get(addr(1), &resolve);
+        REQUIRE(nResolved == 3);
+
+        cache.get(addr(2), &resolve);
+        REQUIRE(nResolved == 4);
+
+        cache.setCapacity(1);
+        REQUIRE(cache.size() == 1);
+
+        cache.setCapacity(0);
+        REQUIRE(cache.size() == 0);
+        REQUIRE(cache.get(addr(5), &resolve) == "5");
+        REQUIRE(cache.size() == 0);
+    }
+
+    SECTION("Concurrent access")
+    {
+        sp::details::SymbolCache cache{16};
+
+        std::vector<std::thread> threads{};
+        std::atomic<int> nWrong{0};
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back(
+                [&cache, &nWrong]()
+                {
+                    for (std::uintptr_t i = 0; i < 10000; ++i)
+                    {
+                        std::uintptr_t a = (i * 7) % 32;
+                        nWrong += cache.get(addr(a), &resolve) != std::to_string(a);
+                    }
+                }
+            );
+        }
+        for (auto & t : threads) t.join();
+
+        REQUIRE(nWrong == 0);
+        REQUIRE(cache.size() == 16);
+    }
+
+#if SPIRIT_USE_STACKTRACE
+    SECTION("Errors share resolved frames")
+    {
+        sp::details::SymbolCache & global = sp::details::SymbolCache::global();
+        global.clear();
+
+        std::string first = sp::SpiritError{"same"}.what();
+        std::size_t nCached = global.size();
+        REQUIRE(nCached > 0);
+
+        // the calling frames are the same
+        for (int i = 0; i < 10; ++i)
+        {
+            std::string what = sp::SpiritError{"same"}.what();
+            REQUIRE(what.substr(what.find("1# ")) == first.substr(first.find("1# ")));
+        }
+        REQUIRE(global.size() <= nCached + 10);
+    }
+#endif
+}
@@ -0,0 +1,83 @@
+#include "SPIRIT/Base/Utils/Time/Timer.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <thread>
+
+template <class TimerT>
+void
+checkTimer()
+{
+    TimerT timer{};
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    timer.pause();
+
+    double elapsed = timer.getElapsedMilli();
+    REQUIRE(elapsed >= 19);
+    REQUIRE(elapsed < 200);
+
+    // paused time is not counted
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    REQUIRE(timer.getElapsedMilli() == elapsed);
+
+    timer.start();
+    REQUIRE(timer.getElapsedMilli() >= elapsed);
+
+    timer.reset();
+    REQUIRE(timer.getElapsedMilli() < 19);
+}
+
+TEST_CASE("Timer")
+{
+    SECTION("Timer") { checkTimer<sp::Timer>(); }
+
+    SECTION("TscTimer") { checkTimer<sp::TscTimer>(); }
+}
+
+TEST_CASE("TscClock")
+{
+    sp::TscClock::calibrate();
+
+    if (sp::TscClock::usesTsc())
+        REQUIRE(sp::TscClock::ticksPerNanosecond() > 0);
+    else
+        REQUIRE(sp::TscClock::ticksPerNanosecond() == 0);
+
+    SECTION("Monotonic")
+    {
+        sp::TscClock::time_point last = sp::TscClock::now();
+        for (int i = 0; i < 100000; ++i)
+        {
+            sp::TscClock::time_point now = sp::TscClock::now();
+            REQUIRE(now >= last);
+            last = now;
+        }
+    }
+
+    SECTION("Agrees with steady_clock")
+    {
+        auto toNs = [](auto d)
+        { return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count(); };
+
+        auto steadyStart = std::chrono::steady_clock::now();
+        auto tscStart    = sp::TscClock::now();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+        auto steadyElapsed = toNs(std::chrono::steady_clock::now() - steadyStart);
+        auto tscElapsed    = toNs(sp::TscClock::now() - tscStart);
+
+        // within 1%, and a bit of scheduling noise
+        auto diff = steadyElapsed > tscElapsed ? steadyElapsed - tscElapsed
+                                               : tscElapsed - steadyElapsed;
+        REQUIRE(diff < steadyElapsed / 100 + 100'000);
+
+        // same epoch
+        REQUIRE(
+            std::abs(toNs(
+                sp::TscClock::now().time_since_epoch()
+                - std::chrono::steady_clock::now().time_since_epoch()
+            ))
+            < 1'000'000
+        );
+    }
+}
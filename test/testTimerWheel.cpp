@@ -0,0 +1,173 @@
+#include "SPIRIT/Base/Utils/Time/TimerWheel.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("TimerWheel")
+{
+    sp::TimerWheel wheel{1ms};
+    std::vector<int> fired{};
+
+    SECTION("Fires when the delay elapsed")
+    {
+        wheel.schedule(3ms, [&]() { fired.push_back(3); });
+        wheel.schedule(1ms, [&]() { fired.push_back(1); });
+        wheel.schedule(0ms, [&]() { fired.push_back(0); });
+        REQUIRE(wheel.size() == 3);
+
+        REQUIRE(wheel.advance(500us) == 0); // fractions are carried
+        REQUIRE(wheel.advance(500us) == 2);
+        REQUIRE(fired.size() == 2);
+
+        REQUIRE(wheel.advance(1ms) == 0);
+        REQUIRE(wheel.advance(1ms) == 1);
+        REQUIRE(fired.back() == 3);
+        REQUIRE(wheel.size() == 0);
+        REQUIRE(wheel.getTime() == 3ms);
+    }
+
+    SECTION("Never early")
+    {
+        wheel.advance(700us);
+        wheel.schedule(1ms, [&]() { fired.push_back(1); });
+
+        wheel.advance(900us); // 1.6ms in total, 0.9ms after scheduling
+        REQUIRE(fired.empty());
+
+        wheel.advance(400us);
+        REQUIRE(fired.size() == 1);
+    }
+
+    SECTION("Cancel")
+    {
+        auto a = wheel.schedule(5ms, [&]() { fired.push_back(1); });
+        auto b = wheel.schedule(5ms, [&]() { fired.push_back(2); });
+
+        REQUIRE(wheel.cancel(a));
+        REQUIRE_FALSE(wheel.cancel(a));
+        REQUIRE_FALSE(wheel.cancel(0));
+        REQUIRE(wheel.size() == 1);
+
+        // the node is reused, the old id stays invalid
+        auto c = wheel.schedule(1ms, [&]() { fired.push_back(3); });
+        REQUIRE(c != a);
+        REQUIRE_FALSE(wheel.cancel(a));
+
+        wheel.advance(10ms);
+        REQUIRE(fired == std::vector<int>{3, 2});
+        REQUIRE_FALSE(wheel.cancel(b));
+    }
+
+    SECTION("Long delays cascade")
+    {
+        std::mt19937 gen{3};
+        std::uniform_int_distribution<sp::Int64> dist{1, 10'000'000}; // up to ~3 hours
+
+        std::multimap<sp::Int64, int> expected{};
+        std::vector<sp::Int64> at(1000);
+        for (int i = 0; i < 1000; ++i)
+        {
+            sp::Int64 delay = dist(gen);
+            expected.emplace(delay, i);
+            wheel.schedule(std::chrono::milliseconds{delay}, [&, i]() {
+                at[i] = wheel.getTime() / 1ms;
+                fired.push_back(i);
+            });
+        }
+
+        // uneven steps
+        while (wheel.size() > 0)
+            wheel.advance(std::chrono::milliseconds{dist(gen) / 1000});
+
+        REQUIRE(fired.size() == 1000);
+        for (auto [delay, i] : expected)
+            REQUIRE(at[i] >= delay);
+
+        // fired in order of expiry, up to the advance() granularity
+        for (std::size_t k = 1; k < fired.size(); ++k)
+            REQUIRE(at[fired[k - 1]] <= at[fired[k]]);
+    }
+
+    SECTION("Callbacks may reschedule")
+    {
+        int nFired = 0;
+        std::function<void()> repeat = [&]() {
+            if (++nFired < 5)
+                wheel.schedule(0ms, repeat);
+        };
+        wheel.schedule(0ms, repeat);
+
+        REQUIRE(wheel.advance(1ms) == 1); // not fired again in the same tick
+        REQUIRE(wheel.advance(10ms) == 4);
+        REQUIRE(nFired == 5);
+    }
+
+    SECTION("Clear")
+    {
+        for (int i = 0; i < 100; ++i)
+            wheel.schedule(std::chrono::milliseconds{i * 100}, [&]() { fired.push_back(0); });
+
+        wheel.clear();
+        REQUIRE(wheel.size() == 0);
+        wheel.advance(1h);
+        REQUIRE(fired.empty());
+    }
+
+    SECTION("Huge delays")
+    {
+        sp::TimerWheel fine{1ns};
+        fine.advance(std::chrono::nanoseconds{(sp::Int64{1} << 48) - 10});
+        fine.schedule(std::chrono::hours{24 * 365}, [&]() { fired.push_back(1); });
+
+        fine.advance(std::chrono::hours{24 * 364});
+        REQUIRE(fired.empty());
+        fine.advance(std::chrono::hours{24});
+        REQUIRE(fired.size() == 1);
+    }
+
+    SECTION("Maximal delays")
+    {
+        wheel.schedule(std::chrono::nanoseconds::max(), [&]() { fired.push_back(1); });
+        wheel.advance(std::chrono::nanoseconds::max());
+        REQUIRE(fired.empty());
+        wheel.advance(1ms);
+        REQUIRE(fired.size() == 1);
+
+        // clamped to 2^62 ticks
+        sp::TimerWheel fine{1ns};
+        fine.advance(std::chrono::nanoseconds::max());
+        fine.schedule(std::chrono::nanoseconds::max(), [&]() { fired.push_back(2); });
+        fine.advance(std::chrono::nanoseconds{(sp::Int64{1} << 62) - 1});
+        REQUIRE(fired.size() == 1);
+        fine.advance(1ns);
+        REQUIRE(fired.size() == 2);
+    }
+}
+
+TEST_CASE("TimerWheelThread")
+{
+    sp::TimerWheelThread wheel{1ms};
+    std::atomic<int> nFired{0};
+
+    auto cancelled = wheel.schedule(5ms, [&]() { nFired += 100; });
+    for (int i = 0; i < 10; ++i)
+        wheel.schedule(std::chrono::milliseconds{i}, [&]() { ++nFired; });
+
+    REQUIRE(wheel.cancel(cancelled));
+
+    for (int i = 0; i < 200 && nFired < 10; ++i)
+        std::this_thread::sleep_for(5ms);
+
+    REQUIRE(nFired == 10);
+    REQUIRE(wheel.size() == 0);
+
+    wheel.schedule(1h, []() {});
+    wheel.stop();
+    REQUIRE(wheel.size() == 1);
+}